@@ -0,0 +1,59 @@
+// Record layout probe for problems about sizes, padding and alignment.
+//
+// Not included by the problems: `run_all.py` generates `build/<id>.layout.cpp`, which includes
+// the problem (its `main` renamed) and calls `gto::layout::type` and `gto::layout::field` for
+// every struct and data member listed under `layout` in `problems.json`. Each call prints one
+// line on stdout:
+//
+//     <Type> <sizeof> <alignof> [<ns per element>]
+//     <Type>.<member> <offsetof> <sizeof> <alignof>
+//
+// With `--bench`, `type` also times a hot loop reading one byte of every element of a large
+// array: the throughput cost of padding (fewer elements per cache line).
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace gto::layout {
+
+inline constexpr std::size_t benchElements = std::size_t{1} << 18;
+inline constexpr int benchRounds = 10;
+
+// Best time of `benchRounds` passes over `benchElements` value-initialized elements, per element.
+template <class T>
+double nsPerElement() {
+    std::vector<T> items(benchElements);
+    unsigned sink = 0;
+    double best = -1;
+    for (int round = 0; round < benchRounds; ++round) {
+        const auto start = std::chrono::steady_clock::now();
+        for (const T& item : items) {
+            unsigned char byte;
+            std::memcpy(&byte, &item, 1);
+            sink += byte;
+        }
+        const std::chrono::duration<double, std::nano> elapsed =
+            std::chrono::steady_clock::now() - start;
+        if (best < 0 || elapsed.count() < best) best = elapsed.count();
+    }
+    volatile unsigned keep = sink;
+    (void)keep;
+    return best / static_cast<double>(benchElements);
+}
+
+template <class T>
+void type(const char* name, bool bench) {
+    std::printf("%s %zu %zu", name, sizeof(T), alignof(T));
+    if (bench) std::printf(" %.3f", nsPerElement<T>());
+    std::printf("\n");
+}
+
+inline void field(const char* name, std::size_t offset, std::size_t size, std::size_t align) {
+    std::printf("%s %zu %zu %zu\n", name, offset, size, align);
+}
+
+}  // namespace gto::layout
@@ -0,0 +1,91 @@
+// Object lifecycle tracer for problems about copies and moves (`#include <gto/lifecycle.hpp>`).
+//
+// `gto::Traced` is an int-holding value type that counts its special member calls into one
+// per-process table. At exit, the table is appended to the file named by `GTO_TRACE_FILE` (set by
+// `run_all.py`), as `lifecycle.<counter> <count>` lines; nothing is printed on stdout.
+//
+// `gto::TracedThrowingMove` is the same type with a move constructor and move assignment that
+// are not `noexcept`, e.g. to show `std::vector` copying instead of moving on reallocation.
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace gto {
+
+struct LifecycleCounts {
+    long constructed = 0;  // from a value
+    long defaultConstructed = 0;
+    long copyConstructed = 0;
+    long moveConstructed = 0;
+    long copyAssigned = 0;
+    long moveAssigned = 0;
+    long destroyed = 0;
+};
+
+inline LifecycleCounts lifecycle;
+
+namespace detail {
+
+// Destroyed after every `Traced` with static storage duration of the problem (all are
+// initialized after it), so the written counts are complete.
+struct LifecycleReport {
+    LifecycleReport() = default;
+    LifecycleReport(const LifecycleReport&) = delete;
+    LifecycleReport& operator=(const LifecycleReport&) = delete;
+
+    ~LifecycleReport() {
+        const char* path = std::getenv("GTO_TRACE_FILE");
+        if (!path) return;
+        std::FILE* file = std::fopen(path, "a");
+        if (!file) return;
+        std::fprintf(file,
+                     "lifecycle.constructed %ld\n"
+                     "lifecycle.defaultConstructed %ld\n"
+                     "lifecycle.copyConstructed %ld\n"
+                     "lifecycle.moveConstructed %ld\n"
+                     "lifecycle.copyAssigned %ld\n"
+                     "lifecycle.moveAssigned %ld\n"
+                     "lifecycle.destroyed %ld\n",
+                     lifecycle.constructed, lifecycle.defaultConstructed,
+                     lifecycle.copyConstructed, lifecycle.moveConstructed,
+                     lifecycle.copyAssigned, lifecycle.moveAssigned, lifecycle.destroyed);
+        std::fclose(file);
+    }
+};
+
+inline LifecycleReport lifecycleReport;
+
+}  // namespace detail
+
+template <bool NoexceptMove>
+struct BasicTraced {
+    int value = 0;
+
+    BasicTraced() { ++lifecycle.defaultConstructed; }
+    BasicTraced(int v) : value(v) { ++lifecycle.constructed; }  // implicit on purpose
+    BasicTraced(const BasicTraced& other) : value(other.value) { ++lifecycle.copyConstructed; }
+    BasicTraced(BasicTraced&& other) noexcept(NoexceptMove) : value(other.value) {
+        other.value = 0;
+        ++lifecycle.moveConstructed;
+    }
+
+    BasicTraced& operator=(const BasicTraced& other) {
+        value = other.value;
+        ++lifecycle.copyAssigned;
+        return *this;
+    }
+    BasicTraced& operator=(BasicTraced&& other) noexcept(NoexceptMove) {
+        value = other.value;
+        other.value = 0;
+        ++lifecycle.moveAssigned;
+        return *this;
+    }
+
+    ~BasicTraced() { ++lifecycle.destroyed; }
+};
+
+using Traced = BasicTraced<true>;
+using TracedThrowingMove = BasicTraced<false>;
+
+}  // namespace gto
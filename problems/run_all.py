@@ -1,20 +1,64 @@
 #!/usr/bin/env python3
 
+import argparse
+import hashlib
 import json
 import subprocess
 import pathlib
 import sys
 import re
+import base64
+import shutil
+import tempfile
+import concurrent.futures
+import gzip
+import heapq
+import os
+import statistics
+import struct
+import threading
+import time
+
+try:
+    import brotli  # optional: `pip install brotli` to also emit .br siblings
+except ImportError:
+    brotli = None
 
 ROOT = pathlib.Path(__file__).resolve().parents[1]
 PROBLEMS_JSON = ROOT / "problems" / "problems.json"
 PROBLEMS_SRC = ROOT / "problems" / "src"
 OUTPUT_JSON = ROOT / "web" / "data" / "problems.generated.json"
-OUTPUT_JSON_INDEX = ROOT / "web" / "data" / "problems.index.json"
+OUTPUT_JSON_FACETS = ROOT / "web" / "data" / "problems.facets.json"
+OUTPUT_JSON_COMPACT = ROOT / "web" / "data" / "problems.compact.json"
+# Fetched lazily by the client, so it lives in the static assets.
+OUTPUT_SEARCH_INDEX = ROOT / "web" / "public" / "generated" / "search-index.json"
+
+# Caches, costs and shards. Binaries, probes and traces go to BIN_DIR (the Makefile's), the same
+# directory unless `--bin-dir` or `--in-memory` move them (see `use_bin_dir`).
+BUILD_DIR = ROOT / "problems" / "build"
+BIN_DIR = BUILD_DIR
 
-MAKE_CMD = ["make"]
+# Sharded runs (`--shard i/N`, then `merge`).
+SHARDS_DIR = BUILD_DIR / "shards"
+COSTS_JSON = BUILD_DIR / "costs.json"  # compile/run stage seconds per problem, last measured
+SHARD_FORMAT = 1
+# Cost of problems never measured: a compile with every artifact of a clean run, on one job, is
+# about 1.3 s whatever the size of the source (410 s for 309 problems).
+ESTIMATED_COMPILE_SECONDS = 1.25
+ESTIMATED_SECONDS_PER_SOURCE_KB = 0.25
+
+MAKE_CMD = ["make", f"BIN_DIR={BIN_DIR}"]
 TIMEOUT = 2  # seconds
 
+# `--in-memory`: a private directory on a RAM-backed filesystem for everything a run writes but
+# the web data, the caches and the costs, removed at exit. g++'s temporary files follow (TMPDIR).
+RAM_FILESYSTEMS = {"tmpfs", "ramfs"}
+RAM_DIR_CANDIDATES = ["/dev/shm", os.environ.get("XDG_RUNTIME_DIR", "")]
+
+# Job kinds of the scheduler; runs go first, they are short and free a finished problem.
+RUN_STAGE = 0
+COMPILE_STAGE = 1
+
 ANSI_PATTERN = re.compile(r'(\x1b\[[0-9;]*[m|K])')
 
 ANSI_COLOR_MAP = {
@@ -31,26 +75,650 @@ ANSI_STYLE_MAP = {
 }
 
 SRC_FILE_PATTERN = re.compile(r'src/([a-zA-Z0-9_]+)\.cpp:')
+# Linker errors name the compiler's temporary object file (random name): keep the output stable.
+TEMP_OBJECT_PATTERN = re.compile(r'/tmp/cc[a-zA-Z0-9]+\.o\b')
+
+# Maximum number of tokens in error messages (after ANSI parsing). The review panel collapses and
+# windows long diagnostics, so this only bounds the data size.
+MAX_ERROR_MESSAGE_TOKEN = 2000
+
+# Diagnostic structure of error messages (see `diagnostic_sections`).
+DIAGNOSTIC_KINDS = ["error", "backtrace", "note", "text"]
+DIAGNOSTIC_CONTEXT_PATTERN = re.compile(
+    r"(?:^\s*|: )In (?:file included from|instantiation of|substitution of|"
+    r"(?:static )?(?:member )?function|constructor|destructor|lambda function)|"
+    r"^\s+from |: in function `|:\s+(?:recursively )?required (?:from|by) "
+)
+DIAGNOSTIC_PRIMARY_PATTERN = re.compile(
+    r"\b(?:fatal error|error|warning): |undefined reference to "
+)
+DIAGNOSTIC_NOTE_PATTERN = re.compile(r"\bnote: ")
+DIAGNOSTIC_EXCERPT_PATTERN = re.compile(r"^\s*\d* \|")
 
-MAX_ERROR_MESSAGE_TOKEN = 150  # Maximum number of tokens in error messages (after ANSI parsing)
+# How the player answers: the stdout (or outcome), or the counts of `problems/include/gto/`
+# tracers, written by the program to `GTO_TRACE_FILE` as `<section>.<counter> <count>` lines.
+ANSWER_MODES = ["output", "lifecycle", "optimization", "layout", "outputs", "compileTime"]
+LIFECYCLE_COUNTERS = [
+    "constructed", "defaultConstructed", "copyConstructed", "moveConstructed", "copyAssigned",
+    "moveAssigned", "destroyed",
+]
 
-def run_command(cmd, stdin=None):
+def run_command(cmd, stdin=None, env=None, timeout=TIMEOUT):
     try:
         proc = subprocess.run(
             cmd,
             input=stdin,
             text=True,
             capture_output=True,
-            timeout=TIMEOUT,
-            cwd=ROOT / "problems"
+            timeout=timeout,
+            cwd=ROOT / "problems",
+            env=env
         )
         return proc
     except subprocess.TimeoutExpired:
         return None
 
+# Optimizer remarks (`make remarks`: GCC -fopt-info, Clang -Rpass), for "optimization" problems
+# (does the loop on line N vectorize, is the call on line N inlined) or every problem with
+# `--opt-report`. Only the remarks on the problem's own code are kept.
+REMARK_KINDS = ["optimized", "missed"]
+REMARK_PASSES = ["vectorize", "inline", "other"]
+MAX_REMARKS = 50
+REMARK_PATTERN = re.compile(
+    r"^src/(?P<pid>\w+)\.cpp:(?P<line>\d+):(?P<column>\d+): "
+    r"(?P<kind>optimized|missed|remark): +(?P<message>.*?)"
+    r"(?: \[-Rpass(?P<clang_missed>-missed)?=(?P<clang_pass>[\w-]+)\])?$"
+)
+REMARK_NOISE_PATTERN = re.compile(
+    r"std::|static initializers|__static_initialization|statement clobbers memory"
+)
+# GCC symbol order numbers (`main()/518`) and inliner size estimates change from build to build.
+REMARK_SYMBOL_ORDER_PATTERN = re.compile(r"(?<=[\w)>])/\d+\b")
+REMARK_INLINE_STATS_PATTERN = re.compile(r" which now has time .*$")
+
+def remark_pass(message: str, clang_pass) -> str:
+    name = clang_pass or message
+    if "vectoriz" in name:
+        return "vectorize"
+    if "inlin" in name.lower():
+        return "inline"
+    return "other"
+
+def parse_remarks(stderr: str, pid: str):
+    """Remarks as {line, column, kind, pass, message}, deduplicated, in source order."""
+    remarks = []
+    seen = set()
+    for raw in stderr.splitlines():
+        match = REMARK_PATTERN.match(ANSI_PATTERN.sub("", raw))
+        if not match or match["pid"] != pid or REMARK_NOISE_PATTERN.search(match["message"]):
+            continue
+        kind = match["kind"]
+        if kind == "remark":  # Clang
+            kind = "missed" if match["clang_missed"] else "optimized"
+        message = REMARK_SYMBOL_ORDER_PATTERN.sub("", match["message"])
+        message = REMARK_INLINE_STATS_PATTERN.sub(".", message).strip()
+        remark = {
+            "line": int(match["line"]),
+            "column": int(match["column"]),
+            "kind": kind,
+            "pass": remark_pass(message, match["clang_pass"]),
+            "message": message,
+        }
+        key = (remark["line"], remark["column"], kind, message)
+        if key not in seen:
+            seen.add(key)
+            remarks.append(remark)
+    remarks.sort(key=lambda r: (r["line"], r["column"]))
+    return remarks[:MAX_REMARKS]
+
+def optimization_verdict(problem, remarks):
+    """
+    Whether the optimization asked by an "optimization" problem happened: an "optimized" remark
+    of the asked pass on the asked line. None when the compiler said nothing about that line.
+    """
+    question = problem["optimization"]
+    relevant = [
+        r for r in remarks or [] if r["line"] == question["line"] and r["pass"] == question["pass"]
+    ]
+    if not relevant:
+        return None
+    return any(r["kind"] == "optimized" for r in relevant)
+
+# Assembly listings (`make asm`) at -O0 and -O2, shown side by side at review. Only the functions
+# defined in the problem's source are kept (no library templates, no static initializers), without
+# directives and unused labels, demangled, every instruction tagged with its source line.
+# Listings are written apart from the problem data, one file per distinct listing (see
+# `write_asm_listings`), and cached in `ASM_CACHE_DIR` while the source and the flags don't change.
+ASM_LEVELS = ["-O0", "-O2"]
+ASM_CACHE_DIR = BUILD_DIR / "asm"
+OUTPUT_ASM_DIR = ROOT / "web" / "public" / "generated" / "asm"
+ASM_FILE_PATTERN = re.compile(r'^\s*\.file\s+(\d+)\s+(?:"[^"]*"\s+)?"([^"]+)"')
+ASM_LOC_PATTERN = re.compile(r"^\s*\.loc\s+(\d+)\s+(\d+)")
+ASM_FUNCTION_PATTERN = re.compile(r"^\s*\.type\s+([^,\s]+),\s*@function")
+ASM_SIZE_PATTERN = re.compile(r"^\s*\.size\s+([^,\s]+),")
+ASM_LABEL_PATTERN = re.compile(r"^([^\s:]+):")
+ASM_JUMP_LABEL_PATTERN = re.compile(r"\.L\d+\b")
+MANGLED_NAME_PATTERN = re.compile(r"\b_Z[\w.$]+")
+ASM_COMPILER_FUNCTIONS = ("_GLOBAL__sub_I_", "__static_initialization_and_destruction")
+
+def asm_instruction(line: str) -> str:
+    mnemonic, _, operands = line.strip().partition("\t")
+    return f"{mnemonic:<7} {operands}".rstrip() if operands else mnemonic
+
+def parse_assembly(asm: str, pid: str):
+    """
+    Functions of the problem's source in a `-S -g1` listing, in source order, as
+    {name (mangled), blocks: [[sourceLine or None, text], ...]}: a block is a run of instructions
+    (and the jump labels they use) from the same source line.
+    """
+    source_files = set()
+    functions = set()
+    listing = []
+    current = None
+    line = None
+    for raw in asm.splitlines():
+        if match := ASM_FILE_PATTERN.match(raw):
+            if match[2] == f"src/{pid}.cpp":
+                source_files.add(match[1])
+        elif match := ASM_FUNCTION_PATTERN.match(raw):
+            functions.add(match[1])
+        elif current is None:
+            match = ASM_LABEL_PATTERN.match(raw)
+            if match and match[1] in functions:
+                current = {"name": match[1], "own": None, "lines": []}
+                line = None
+        elif (match := ASM_SIZE_PATTERN.match(raw)) and match[1] == current["name"]:
+            if current["own"] and not any(f in current["name"] for f in ASM_COMPILER_FUNCTIONS):
+                listing.append(current)
+            current = None
+        elif match := ASM_LOC_PATTERN.match(raw):
+            own = match[1] in source_files
+            if current["own"] is None:
+                current["own"] = own
+            line = int(match[2]) if own else None
+        elif match := ASM_LABEL_PATTERN.match(raw):
+            if ASM_JUMP_LABEL_PATTERN.fullmatch(match[1]):
+                current["lines"].append((line, f"{match[1]}:", match[1]))
+        elif raw.strip() and not raw.lstrip().startswith("."):
+            current["lines"].append((line, asm_instruction(raw), None))
+
+    result = []
+    for function in listing:
+        used = {
+            label
+            for _, text, defined in function["lines"] if defined is None
+            for label in ASM_JUMP_LABEL_PATTERN.findall(text)
+        }
+        blocks = []
+        for line, text, defined in function["lines"]:
+            if defined is not None and defined not in used:
+                continue
+            if blocks and blocks[-1][0] == line:
+                blocks[-1][1] += "\n" + text
+            else:
+                blocks.append([line, text])
+        first = min((b[0] for b in blocks if b[0] is not None), default=0)
+        result.append((first, {"name": function["name"], "blocks": blocks}))
+    return [function for _, function in sorted(result, key=lambda item: item[0])]
+
+def demangle_listing(listing):
+    """Demangle function names and the symbols in instructions, with one `c++filt` call."""
+    texts = [
+        text
+        for functions in listing.values()
+        for function in functions
+        for text in [function["name"]] + [block[1] for block in function["blocks"]]
+    ]
+    names = sorted({name for text in texts for name in MANGLED_NAME_PATTERN.findall(text)})
+    if not names:
+        return listing
+    try:
+        proc = subprocess.run(
+            ["c++filt"], input="\n".join(names), text=True, capture_output=True, check=True
+        )
+    except (OSError, subprocess.CalledProcessError):
+        return listing  # no binutils: mangled names are still correct
+    demangled = dict(zip(names, proc.stdout.splitlines()))
+
+    def demangle(text):
+        return MANGLED_NAME_PATTERN.sub(lambda m: demangled.get(m[0], m[0]), text)
+
+    for functions in listing.values():
+        for function in functions:
+            function["name"] = demangle(function["name"])
+            for block in function["blocks"]:
+                block[1] = demangle(block[1])
+    return listing
+
+def source_cache_key(problem, extra: str = "") -> str:
+    """
+    Everything a build of the problem depends on: the source, the flags (Makefile) and the shared
+    headers, plus `extra` (e.g. the stdin of a run).
+    """
+    digest = hashlib.sha256()
+    for path in [PROBLEMS_SRC / f"{problem['id']}.cpp", ROOT / "problems" / "Makefile"]:
+        digest.update(path.read_bytes())
+    for header in sorted((ROOT / "problems" / "include").rglob("*.hpp")):
+        digest.update(header.read_bytes())
+    digest.update(extra.encode("utf-8"))
+    return digest.hexdigest()
+
+def compile_asm(problem):
+    """Assembly listing of a problem that compiles: {"-O0": [function, ...], "-O2": [...]}."""
+    pid = problem["id"]
+    key = source_cache_key(problem)
+    cache = ASM_CACHE_DIR / f"{pid}.json"
+    try:
+        cached = json.loads(cache.read_text(encoding="utf-8"))
+        if cached["key"] == key:
+            return cached["listing"]
+    except (FileNotFoundError, json.JSONDecodeError, KeyError):
+        pass
+
+    listing = {}
+    for level in ASM_LEVELS:
+        proc = run_command(MAKE_CMD + ["-s", "asm", f"NAME={pid}", f"ASM_OPT={level}"])
+        if proc is None or proc.returncode != 0:
+            return None
+        listing[level] = parse_assembly(proc.stdout, pid)
+    listing = demangle_listing(listing)
+
+    cache.parent.mkdir(parents=True, exist_ok=True)
+    cache.write_text(json.dumps({"key": key, "listing": listing}), encoding="utf-8")
+    return listing
+
+# Record layouts (`make layout`) of the structs listed under `layout` in problems.json, printed by
+# a probe generated next to the binary (see `problems/include/gto/layout.hpp`). "layout" problems
+# ask their sizes; `--layout-bench` also times a hot loop over an array of each of them.
+LAYOUT_NAME_PATTERN = re.compile(r"[A-Za-z_]\w*")
+
+def layout_probe_source(problem) -> str:
+    pid = problem["id"]
+    lines = [
+        f"// Generated by run_all.py: record layout probe of src/{pid}.cpp (see `make layout`)",
+        "#define main gto_problem_main",
+        f'#include "{pid}.cpp"',  # found through -I$(SRC_DIR): the probe is in BIN_DIR
+        "#undef main",
+        "",
+        "#include <cstddef>",
+        "#include <cstring>",
+        "#include <gto/layout.hpp>",
+        "",
+        "int main(int argc, char** argv) {",
+        '    const bool bench = argc > 1 && std::strcmp(argv[1], "--bench") == 0;',
+    ]
+    for name, members in problem["layout"].items():
+        lines.append(f'    gto::layout::type<{name}>("{name}", bench);')
+        for member in members:
+            lines.append(
+                f'    gto::layout::field("{name}.{member}", offsetof({name}, {member}), '
+                f"sizeof({name}::{member}), alignof(decltype({name}::{member})));"
+            )
+    lines.append("}")
+    return "\n".join(lines) + "\n"
+
+def parse_layout(stdout: str, problem):
+    """
+    Layouts as [{name, size, align, members: [{name, offset, size, align}], nsPerElement?}], in
+    `problems.json` order (None when the probe printed something else).
+    """
+    types = {}
+    for line in stdout.splitlines():
+        key, *values = line.split() or [""]
+        name, _, member = key.partition(".")
+        if member and name in types and len(values) == 3:
+            offset, size, align = map(int, values)
+            types[name]["members"].append(
+                {"name": member, "offset": offset, "size": size, "align": align}
+            )
+        elif not member and name in problem["layout"] and len(values) in (2, 3):
+            types[name] = {"name": name, "size": int(values[0]), "align": int(values[1])}
+            types[name]["members"] = []
+            if len(values) == 3:
+                types[name]["nsPerElement"] = float(values[2])
+    if list(types) != list(problem["layout"]):
+        return None
+    return list(types.values())
+
+def compile_layout(problem, bench: bool):
+    """Record layouts of the structs of `problem["layout"]` (see `parse_layout`)."""
+    pid = problem["id"]
+    BIN_DIR.mkdir(parents=True, exist_ok=True)
+    (BIN_DIR / f"{pid}.layout.cpp").write_text(layout_probe_source(problem), encoding="utf-8")
+    cmd = MAKE_CMD + ["-s", "layout", f"NAME={pid}"]
+    proc = run_command(cmd + ["LAYOUT_ARGS=--bench"] if bench else cmd)
+    layout = None
+    if proc is not None and proc.returncode == 0:
+        layout = parse_layout(proc.stdout, problem)
+    if layout is None:
+        detail = "timed out" if proc is None else ANSI_PATTERN.sub("", proc.stderr).strip()
+        print(f"[!] {pid}: layout probe failed: {detail[:500]}")
+    return layout
+
+# Concurrency problems (`concurrency` in problems.json): one run says little, so a ThreadSanitizer
+# build with yield injection (`make sched`, see `problems/shim/yield.cpp`) also runs once per seed,
+# `concurrency.runs` times, in parallel. The outputs seen and the races reported are the ground
+# truth of the "outputs" answer mode (which of `concurrency.choices` are possible outputs).
+DEFAULT_SCHEDULE_RUNS = 100
+SCHED_BUILD_TIMEOUT = 60  # seconds, ThreadSanitizer builds are slow
+TSAN_OPTIONS = "halt_on_error=0 exitcode=66 report_signal_unsafe=0"
+TSAN_EXIT_CODE = 66
+TSAN_SUMMARY_PATTERN = re.compile(
+    r"^SUMMARY: ThreadSanitizer: "
+    r"(?:(?P<kind>.+?) (?P<location>\S+) in (?P<function>.+)|(?P<other>.+))$"
+)
+
+def parse_tsan_reports(stderr: str, pid: str):
+    """Reports as {kind, line (in the problem's source, else None), function}."""
+    reports = []
+    for raw in stderr.splitlines():
+        match = TSAN_SUMMARY_PATTERN.match(raw.strip())
+        if not match:
+            continue
+        file, _, line = (match["location"] or "").rpartition(":")
+        own = file.endswith(f"src/{pid}.cpp") and line.isdigit()
+        reports.append({
+            "kind": match["kind"] or match["other"],
+            "line": int(line) if own else None,
+            "function": match["function"],
+        })
+    return reports
+
+def explore_schedules(problem, jobs: int):
+    """
+    Outputs and ThreadSanitizer reports of the instrumented build over `concurrency.runs` seeds:
+    {runs, failed (crashed or timed out), outputs: [{stdout, count}], races: [report]}.
+    """
+    pid = problem["id"]
+    build = run_command(MAKE_CMD + ["sched", f"NAME={pid}"], timeout=SCHED_BUILD_TIMEOUT)
+    if build is None or build.returncode != 0:
+        detail = "timed out" if build is None else ANSI_PATTERN.sub("", build.stderr).strip()
+        print(f"[!] {pid}: instrumented build failed: {detail[:500]}")
+        return None
+
+    binary = BIN_DIR / f"{pid}.sched"
+    runs = problem["concurrency"].get("runs", DEFAULT_SCHEDULE_RUNS)
+
+    def run_seed(seed):
+        env = {**os.environ, "GTO_SEED": str(seed), "TSAN_OPTIONS": TSAN_OPTIONS}
+        return run_command([str(binary)], stdin=problem.get("stdin", ""), env=env)
+
+    with concurrent.futures.ThreadPoolExecutor(max_workers=min(jobs, runs)) as pool:
+        procs = list(pool.map(run_seed, range(1, runs + 1)))
+
+    outputs = {}
+    races = {}
+    failed = 0
+    for proc in procs:
+        if proc is None or proc.returncode not in (0, TSAN_EXIT_CODE):
+            failed += 1
+            continue
+        outputs[proc.stdout] = outputs.get(proc.stdout, 0) + 1
+        for report in parse_tsan_reports(proc.stderr, pid):
+            races.setdefault((report["kind"], report["line"], report["function"]), report)
+
+    return {
+        "runs": runs,
+        "failed": failed,
+        "outputs": [{"stdout": out, "count": count} for out, count in sorted(outputs.items())],
+        "races": sorted(
+            races.values(), key=lambda r: (r["line"] or 0, r["kind"], r["function"] or "")
+        ),
+    }
+
+# Compile-time problems (`compileTime` in problems.json): the source holds two or more variants of
+# the same computation behind `#if GTO_VARIANT == N`, and the "compileTime" answer mode asks which
+# one compiles fastest. GCC's `-ftime-report` (`make ftime`) times the phases of each compile;
+# after warm-up compiles (page cache, CPU frequency), every round compiles all the variants in a
+# rotating order, and samples far from the median are dropped. Compiles are timed one at a time,
+# once the parallel stages are done. GCC has no `-ftime-trace`: template instantiations are
+# counted in its class dump (`make classes`) instead.
+DEFAULT_COMPILE_TIME_REPEAT = 7
+COMPILE_TIME_WARMUP = 1
+COMPILE_TIME_TIMEOUT = 60  # seconds, per compile
+COMPILE_TIME_RESOLUTION = 0.01  # seconds, -ftime-report rounds to it
+COMPILE_TIME_OUTLIER_MADS = 3  # samples further from the median than this many MADs are dropped
+COMPILE_TIME_MIN_GAP = 0.1  # below this relative gap between the two fastest, warn
+TIME_REPORT_ROW_PATTERN = re.compile(r"^\s*\|?(?P<name>[^:|]+?)\s*:(?P<columns>.*)$")
+TIME_REPORT_PERCENT_PATTERN = re.compile(r"\(\s*\d+%\)")
+TIME_REPORT_ROWS = {
+    "frontend": ("phase parsing", "phase lang. deferred"),
+    "instantiation": ("template instantiation",),
+    "constexpr": ("constant expression evaluation",),
+}
+GGC_UNITS = {"": 1, "k": 1 << 10, "M": 1 << 20, "G": 1 << 30}
+CLASS_SPECIALIZATION_PATTERN = re.compile(r"^Class \S*<", re.MULTILINE)
+
+def parse_time_report(stderr: str):
+    """
+    Wall seconds of a `-ftime-report` (`seconds`, and per `TIME_REPORT_ROWS` group) and the
+    GC-allocated bytes of the whole compile (`memory`), or None without a TOTAL row.
+    """
+    walls = {}
+    report = None
+    for raw in stderr.splitlines():
+        match = TIME_REPORT_ROW_PATTERN.match(raw)
+        if not match:
+            continue
+        # usr, sys, wall, GGC memory (e.g. "36M")
+        columns = TIME_REPORT_PERCENT_PATTERN.sub("", match["columns"]).split()
+        if len(columns) != 4:
+            continue
+        try:
+            wall = float(columns[2])
+        except ValueError:
+            continue
+        if match["name"] == "TOTAL":
+            amount, unit = re.fullmatch(r"(\d+)([kMG]?)", columns[3]).groups()
+            report = {"seconds": wall, "memory": int(amount) * GGC_UNITS[unit]}
+        else:
+            walls[match["name"]] = wall
+    if report is None:
+        return None
+    for group, rows in TIME_REPORT_ROWS.items():
+        report[group] = round(sum(walls.get(row, 0.0) for row in rows), 3)
+    return report
+
+def kept_samples(samples):
+    """`samples` without the outliers (further than a few MADs from the median)."""
+    median = statistics.median(samples)
+    spread = statistics.median(abs(sample - median) for sample in samples)
+    limit = COMPILE_TIME_OUTLIER_MADS * max(spread, COMPILE_TIME_RESOLUTION)
+    return [sample for sample in samples if abs(sample - median) <= limit]
+
+def measure_compile_time(problem):
+    """
+    Compile cost of every variant of a compile-time problem, or None if one does not compile:
+    {fastest (index), variants: [{label, seconds, frontend, instantiation, constexpr, memory,
+    classes, samples}]}. Times are median wall seconds of the kept samples (`samples`); `memory`
+    (GC-allocated bytes) and `classes` (class template specializations) are deterministic.
+    """
+    pid = problem["id"]
+    labels = problem["compileTime"]["variants"]
+    repeat = problem["compileTime"].get("repeat", DEFAULT_COMPILE_TIME_REPEAT)
+    reports = [[] for _ in labels]
+
+    for round_index in range(COMPILE_TIME_WARMUP + repeat):
+        for offset in range(len(labels)):
+            variant = (round_index + offset) % len(labels)
+            proc = run_command(
+                MAKE_CMD + ["-s", "ftime", f"NAME={pid}", f"VARIANT={variant}"],
+                timeout=COMPILE_TIME_TIMEOUT,
+            )
+            report = parse_time_report(proc.stderr) if proc and proc.returncode == 0 else None
+            if report is None:
+                detail = "timed out" if proc is None else ANSI_PATTERN.sub("", proc.stderr).strip()
+                print(f"[!] {pid}: variant {variant} failed to compile: {detail[-500:]}")
+                return None
+            if round_index >= COMPILE_TIME_WARMUP:
+                reports[variant].append(report)
+
+    variants = []
+    for variant, (label, samples) in enumerate(zip(labels, reports)):
+        kept = kept_samples([report["seconds"] for report in samples])
+        kept_reports = [report for report in samples if report["seconds"] in kept]
+        proc = run_command(
+            MAKE_CMD + ["-s", "classes", f"NAME={pid}", f"VARIANT={variant}"],
+            timeout=COMPILE_TIME_TIMEOUT,
+        )
+        variants.append({
+            "label": label,
+            **{
+                key: round(statistics.median(report[key] for report in kept_reports), 3)
+                for key in ("seconds", *TIME_REPORT_ROWS)
+            },
+            "memory": int(statistics.median(report["memory"] for report in samples)),
+            "classes": (
+                len(CLASS_SPECIALIZATION_PATTERN.findall(proc.stdout))
+                if proc and proc.returncode == 0 else None
+            ),
+            "samples": sorted(kept),
+        })
+
+    ranked = sorted(range(len(variants)), key=lambda index: variants[index]["seconds"])
+    fastest, runner_up = (variants[index]["seconds"] for index in ranked[:2])
+    if runner_up - fastest < COMPILE_TIME_MIN_GAP * runner_up:
+        print(
+            f"[!] {pid}: the two fastest variants compile within {COMPILE_TIME_MIN_GAP:.0%} "
+            f"({fastest}s, {runner_up}s), the answer may differ between machines"
+        )
+    return {"fastest": ranked[0], "variants": variants}
+
+# Line coverage (`--coverage`): problems that run successfully are also built with gcov
+# instrumentation at -O0 in `build/cover/` (`make cover`, apart from the normal binaries) and run
+# once with their stdin. The execution count of every line of the source is cached in
+# `COVERAGE_DIR` until the source, the Makefile, the headers or the stdin change, and stored as
+# runs of consecutive lines with the same count: the heat gutter of the review panel.
+COVERAGE_DIR = BUILD_DIR / "cover"
+COVERAGE_TIMEOUT = 10  # seconds, build and instrumented run
+
+def parse_gcov(stdout: str, pid: str):
+    """{line: count} of the problem's source (template instantiations summed), or None."""
+    try:
+        report = json.loads(stdout)
+    except json.JSONDecodeError:
+        return None
+    counts = {}
+    for file in report.get("files", []):
+        if not file["file"].endswith(f"src/{pid}.cpp"):
+            continue
+        for line in file["lines"]:
+            counts[line["line_number"]] = counts.get(line["line_number"], 0) + line["count"]
+    return counts
+
+def line_count_runs(counts):
+    """{line: count} as [{line, length, count}] runs of consecutive lines with the same count."""
+    runs = []
+    for line, count in sorted(counts.items()):
+        last = runs[-1] if runs else None
+        if last and last["line"] + last["length"] == line and last["count"] == count:
+            last["length"] += 1
+        else:
+            runs.append({"line": line, "length": 1, "count": count})
+    return runs
+
+def line_coverage(problem):
+    """Execution count runs of a problem's lines (see `line_count_runs`), or None."""
+    pid = problem["id"]
+    key = source_cache_key(problem, problem.get("stdin", ""))
+    cache = COVERAGE_DIR / f"{pid}.json"
+    try:
+        cached = json.loads(cache.read_text(encoding="utf-8"))
+        if cached["key"] == key:
+            return cached["coverage"]
+    except (FileNotFoundError, json.JSONDecodeError, KeyError):
+        pass
+
+    proc = run_command(
+        MAKE_CMD + ["-s", "cover", f"NAME={pid}"],
+        stdin=problem.get("stdin", ""),
+        timeout=COVERAGE_TIMEOUT,
+    )
+    counts = parse_gcov(proc.stdout, pid) if proc and proc.returncode == 0 else None
+    if not counts:
+        detail = "timed out" if proc is None else ANSI_PATTERN.sub("", proc.stderr).strip()
+        print(f"[!] {pid}: no line coverage: {detail[-500:]}")
+        return None
+    coverage = line_count_runs(counts)
+
+    cache.parent.mkdir(parents=True, exist_ok=True)
+    cache.write_text(json.dumps({"key": key, "coverage": coverage}), encoding="utf-8")
+    return coverage
+
+# Heap timelines (`heapTimeline` in problems.json): the problem is also built linked with
+# `problems/shim/heap.cpp` (`make heap`), with the same flags, and run once with its stdin. Each
+# `operator new` and `operator delete` of the run is an event {op (alloc|free), block (numbered in
+# allocation order), bytes, line (lines of output written before it)}: the timeline drawn next to
+# the output in the review panel. UB problems get one too, though their output is not shown.
+HEAP_TIMEOUT = 30  # seconds, build and run
+HEAP_EVENT_PATTERN = re.compile(
+    r"^(?P<op>alloc|free) (?P<block>\d+) (?P<bytes>\d+) (?P<line>\d+)$"
+)
+
+def parse_heap_trace(text: str):
+    """{events: [{op, block, bytes, line}], truncated} of a heap trace (see shim/heap.cpp)."""
+    events = []
+    truncated = False
+    for raw in text.splitlines():
+        match = HEAP_EVENT_PATTERN.match(raw)
+        if match:
+            events.append({
+                "op": match["op"],
+                "block": int(match["block"]),
+                "bytes": int(match["bytes"]),
+                "line": int(match["line"]),
+            })
+        elif raw == "truncated":
+            truncated = True
+    return {"events": events, "truncated": truncated}
+
+def heap_timeline(problem):
+    """
+    Heap events of one run of the instrumented build (see `parse_heap_trace`), with the `stdout`
+    of that run, or None.
+    """
+    pid = problem["id"]
+    build = run_command(MAKE_CMD + ["heap", f"NAME={pid}"], timeout=HEAP_TIMEOUT)
+    if build is None or build.returncode != 0:
+        detail = "timed out" if build is None else ANSI_PATTERN.sub("", build.stderr).strip()
+        print(f"[!] {pid}: heap timeline build failed: {detail[:500]}")
+        return None
+
+    trace_path = BIN_DIR / f"{pid}.heap.trace"
+    trace_path.unlink(missing_ok=True)
+    proc = run_command(
+        [str(BIN_DIR / f"{pid}.heap")],
+        stdin=problem.get("stdin", ""),
+        env={**os.environ, "GTO_TRACE_FILE": str(trace_path)},
+        timeout=HEAP_TIMEOUT,
+    )
+    # Written at exit: an abort loses the events.
+    if proc is None or proc.returncode != 0 or not trace_path.exists():
+        detail = "timed out" if proc is None else f"exit code {proc.returncode}"
+        print(f"[!] {pid}: no heap timeline: {detail}")
+        return None
+    timeline = parse_heap_trace(trace_path.read_text(encoding="utf-8"))
+    if not timeline["events"]:
+        print(f"[!] {pid}: heapTimeline but the run allocated nothing")
+        return None
+    if timeline["truncated"]:
+        print(f"[!] {pid}: heap timeline truncated after {len(timeline['events'])} events")
+    return {**timeline, "stdout": proc.stdout}
+
+def read_trace(path: pathlib.Path):
+    """Tracer counts of a run, by section: {"lifecycle": {"copyConstructed": 2, ...}}."""
+    trace = {}
+    if not path.exists():
+        return trace
+    for line in path.read_text(encoding="utf-8").splitlines():
+        key, _, count = line.partition(" ")
+        section, _, counter = key.partition(".")
+        trace.setdefault(section, {})[counter] = int(count)
+    return trace
+
 def strip_runner_line(stdout: str, pid: str) -> str:
     lines = stdout.splitlines(keepends=True)
-    if lines and lines[0].strip() == f"./build/{pid}":
+    if lines and lines[0].strip() == f"{BIN_DIR}/{pid}":
         return "".join(lines[1:])
     return stdout
 
@@ -96,6 +764,7 @@ def ansi_to_tokens(text: str):
         
         # Payload text
         part = SRC_FILE_PATTERN.sub("", part)
+        part = TEMP_OBJECT_PATTERN.sub("program.o", part)
         if part:
             spans.append({
                 "color": current_color,
@@ -105,84 +774,1053 @@ def ansi_to_tokens(text: str):
 
     return spans[:MAX_ERROR_MESSAGE_TOKEN]
 
-def main():
+def message_lines(tokens):
+    """Lines of an error message (a trailing newline does not start a new line)."""
+    lines = "".join(token["text"] for token in tokens).split("\n")
+    if lines and lines[-1] == "":
+        lines.pop()
+    return lines
+
+def diagnostic_sections(tokens):
+    """
+    Split an error message into [kind, lineCount] sections (`DIAGNOSTIC_KINDS`), so the client
+    can collapse what is long and rarely read:
+    - "error": an error/warning line and its source excerpt; every one starts a new section
+    - "backtrace": the context printed before it (enclosing function, instantiation chain)
+    - "note": the notes following it, with their excerpts
+    - "text": anything else (runtime errors, linker output)
+    """
+    sections = []
+    for line in message_lines(tokens):
+        if DIAGNOSTIC_CONTEXT_PATTERN.search(line):
+            kind = "backtrace"
+        elif DIAGNOSTIC_PRIMARY_PATTERN.search(line):
+            sections.append(["error", 1])
+            continue
+        elif DIAGNOSTIC_NOTE_PATTERN.search(line):
+            kind = "note"
+        elif DIAGNOSTIC_EXCERPT_PATTERN.match(line) and sections:
+            kind = sections[-1][0]
+        else:
+            kind = "text"
+
+        if sections and sections[-1][0] == kind:
+            sections[-1][1] += 1
+        else:
+            sections.append([kind, 1])
+    return sections
+
+def encode_bitset(positions, size: int) -> str:
+    """Bitset over problem positions: little-endian uint32 words, base64 encoded."""
+    words = [0] * ((size + 31) // 32)
+    for pos in positions:
+        words[pos >> 5] |= 1 << (pos & 31)
+    return base64.b64encode(struct.pack(f"<{len(words)}I", *words)).decode("ascii")
+
+def encode_facet(positions, size: int):
+    """Sparse facets stay sorted position lists (smaller than a bitset), dense ones are bitsets."""
+    if len(positions) * 32 < size:
+        return positions
+    return encode_bitset(positions, size)
+
+def build_facets(problem_index):
+    """
+    Facet index used by the home page to filter problems without scanning them:
+    concepts are interned (in order of first appearance) and every concept/difficulty
+    maps to the problems (positions in `problemIds`) that have it, see `encode_facet`.
+    """
+    size = len(problem_index)
+    concepts = []
+    concept_ids = {}
+    by_concept = []
+    by_difficulty = {}
+
+    for pos, entry in enumerate(problem_index):
+        by_difficulty.setdefault(entry["difficulty"], []).append(pos)
+        for concept in entry["concepts"]:
+            if concept not in concept_ids:
+                concept_ids[concept] = len(concepts)
+                concepts.append(concept)
+                by_concept.append([])
+            positions = by_concept[concept_ids[concept]]
+            if not positions or positions[-1] != pos:
+                positions.append(pos)
+
+    return {
+        "version": 1,
+        "size": size,
+        "problemIds": [entry["id"] for entry in problem_index],
+        "concepts": concepts,
+        "conceptCounts": [len(positions) for positions in by_concept],
+        "byConcept": [encode_facet(positions, size) for positions in by_concept],
+        "difficultyCounts": {str(d): len(p) for d, p in sorted(by_difficulty.items())},
+        "byDifficulty": {str(d): encode_facet(p, size) for d, p in sorted(by_difficulty.items())},
+    }
+
+ERROR_TYPES = ["no-error", "compilation-error", "runtime-error", "undefined-behavior"]
+
+# Positional layout of a problem in the compact encoding. `result` is the stdout for "no-error",
+# the error message runs for errors, and null for undefined behavior. `sections` is the flat
+# [kindIndex, lineCount, ...] diagnostic structure of the error message (null without one).
+# `answerMode` is null for "output", `lifecycle` the counts in `LIFECYCLE_COUNTERS` order,
+# `optimization` the [passIndex, line, optimized] question and answer of "optimization" problems and
+# `remarks` flat [line, column, kindIndex, passIndex, message, ...] records, `asm` the name of
+# the assembly listing (see `write_asm_listings`), `layout` one
+# [name, size, align, [member, offset, size, align, ...], nsPerElement?] tuple per struct,
+# `schedules` the [runs, failed, [stdout, count, ...], [kind, line, function, ...]] exploration of
+# concurrency problems and `choices` their candidate outputs, `compileTime` the
+# [fastest, [label, seconds, frontend, instantiation, constexpr, memory, classes, [sample, ...]],
+# ...] timings of compile-time problems, `coverage` the flat [line, length, count, ...] runs of
+# line execution counts, `heap` the [truncated, line, block, bytes, ...] heap timeline with line
+# and block as deltas from the previous event (a block above every earlier one is an allocation,
+# any other a release). Trailing null fields are left out.
+COMPACT_FIELDS = [
+    "id", "title", "difficulty", "concepts", "explanation", "code", "stdin", "errorType", "result",
+    "sections", "answerMode", "lifecycle", "optimization", "remarks", "asm", "layout", "schedules",
+    "choices", "compileTime", "coverage", "heap",
+]
+
+def encode_heap_timeline(heap):
+    """[truncated, line delta, block delta, bytes, ...] (see `COMPACT_FIELDS`)."""
+    encoded = [1 if heap["truncated"] else 0]
+    line = block = 0
+    for event in heap["events"]:
+        encoded += [event["line"] - line, event["block"] - block, event["bytes"]]
+        line, block = event["line"], event["block"]
+    return encoded
+
+def encode_compact(generated):
+    """
+    Compact encoding of the generated problems (decoded by `decodeCompactProblems` in
+    `web/src/lib/problems.ts`):
+    - concepts are a deduplicated string table, problems reference them by index
+    - error messages are flat [paletteIndex, text, ...] runs, where the palette holds the
+      distinct (color, style) pairs and adjacent runs with the same style are merged
+    - each problem is a positional tuple (see `COMPACT_FIELDS`)
+    """
+    palette = []
+    palette_ids = {}
+    concepts = []
+    concept_ids = {}
+
+    def intern(table, ids, value):
+        if value not in ids:
+            ids[value] = len(table)
+            table.append(value)
+        return ids[value]
+
+    def encode_runs(tokens):
+        runs = []
+        for token in tokens:
+            style = intern(palette, palette_ids, (token["color"], token["style"]))
+            if runs and runs[-2] == style:
+                runs[-1] += token["text"]
+            else:
+                runs += [style, token["text"]]
+        return runs
+
+    problems = []
+    for problem in generated:
+        result = problem["result"]
+        error_type = result["errorType"]
+        sections = None
+        if error_type == "no-error":
+            payload = result["stdout"]
+        elif error_type == "undefined-behavior":
+            payload = None
+        else:
+            payload = encode_runs(result.get("errorMessage") or [])
+            sections = [
+                value
+                for kind, count in result.get("errorSections") or []
+                for value in (DIAGNOSTIC_KINDS.index(kind), count)
+            ]
+
+        lifecycle = result.get("lifecycle")
+        schedules = result.get("schedules")
+        compile_time = result.get("compileTime")
+        question = problem.get("optimization") if "optimized" in result else None
+        fields = [
+            problem["id"],
+            problem["title"],
+            problem["difficulty"],
+            [intern(concepts, concept_ids, c) for c in problem["concepts"]],
+            problem["explanation"],
+            problem["code"],
+            problem.get("stdin"),
+            ERROR_TYPES.index(error_type),
+            payload,
+            sections or None,
+            None if problem.get("answerMode", "output") == "output" else problem["answerMode"],
+            [lifecycle[name] for name in LIFECYCLE_COUNTERS] if lifecycle else None,
+            [
+                REMARK_PASSES.index(question["pass"]),
+                question["line"],
+                result["optimized"],
+            ] if question else None,
+            [
+                value
+                for r in result.get("remarks") or []
+                for value in (
+                    r["line"],
+                    r["column"],
+                    REMARK_KINDS.index(r["kind"]),
+                    REMARK_PASSES.index(r["pass"]),
+                    r["message"],
+                )
+            ] or None,
+            problem.get("asm"),
+            [
+                [
+                    t["name"],
+                    t["size"],
+                    t["align"],
+                    [
+                        value
+                        for f in t["members"]
+                        for value in (f["name"], f["offset"], f["size"], f["align"])
+                    ],
+                    *([t["nsPerElement"]] if "nsPerElement" in t else []),
+                ]
+                for t in result["layout"]
+            ] if result.get("layout") else None,
+            [
+                schedules["runs"],
+                schedules["failed"],
+                [value for o in schedules["outputs"] for value in (o["stdout"], o["count"])],
+                [
+                    value
+                    for r in schedules["races"]
+                    for value in (r["kind"], r["line"], r["function"])
+                ],
+            ] if schedules else None,
+            (problem.get("concurrency") or {}).get("choices"),
+            [
+                compile_time["fastest"],
+                *(
+                    [
+                        v["label"], v["seconds"], v["frontend"], v["instantiation"],
+                        v["constexpr"], v["memory"], v["classes"], v["samples"],
+                    ]
+                    for v in compile_time["variants"]
+                ),
+            ] if compile_time else None,
+            [
+                value
+                for run in result.get("coverage") or []
+                for value in (run["line"], run["length"], run["count"])
+            ] or None,
+            encode_heap_timeline(result["heap"]) if result.get("heap") else None,
+        ]
+        while fields[-1] is None:
+            fields.pop()
+        problems.append(fields)
+
+    return {
+        "format": 1,
+        "fields": COMPACT_FIELDS,
+        "errorTypes": ERROR_TYPES,
+        "diagnosticKinds": DIAGNOSTIC_KINDS,
+        "lifecycleCounters": LIFECYCLE_COUNTERS,
+        "remarkKinds": REMARK_KINDS,
+        "remarkPasses": REMARK_PASSES,
+        "palette": [list(pair) for pair in palette],
+        "concepts": concepts,
+        "problems": problems,
+    }
+
+SEARCH_FIELD_WEIGHTS = {"title": 8, "concepts": 6, "code": 2, "explanation": 1}
+SEARCH_MAX_TF = 3                     # per field: repeating a word stops helping after this
+SEARCH_MAX_TERMS_PER_PROBLEM = 200    # bounds the index to O(problems) postings
+SEARCH_COMMON_DOC_RATIO = 0.5         # terms found in more problems than this are not indexed
+SEARCH_WORD_PATTERN = re.compile(r"[a-z0-9_]+")
+SEARCH_STOP_WORDS = {
+    "a", "an", "and", "are", "as", "at", "be", "but", "by", "can", "do", "does", "for", "from",
+    "has", "have", "here", "if", "in", "is", "it", "its", "not", "of", "on", "or", "so", "than",
+    "that", "the", "then", "there", "this", "to", "was", "we", "when", "which", "will", "with",
+    "you", "your",
+}
+CODE_NOISE_PATTERN = re.compile(
+    r'//[^\n]*|/\*.*?\*/|"(?:\\.|[^"\\\n])*"|\'(?:\\.|[^\'\\\n])*\'',
+    re.DOTALL,
+)
+
+def search_tokens(text: str):
+    """Lowercase words; snake_case identifiers also index their parts. Same rules as the client."""
+    for word in SEARCH_WORD_PATTERN.findall(text.lower()):
+        parts = [word] + ([p for p in word.split("_") if p] if "_" in word.strip("_") else [])
+        for part in parts:
+            if len(part) >= 2 and not part.isdigit() and part not in SEARCH_STOP_WORDS:
+                yield part
+
+def build_search_index(generated):
+    """
+    Inverted index for the client-side problem search (see `web/src/lib/search`).
+    Terms are sorted so the client can prefix-search them with a binary search; each term has a
+    flat posting list [positionDelta, weight, ...] over the problems (positions in `problemIds`).
+    Code is indexed without comments and string literals, which could give the output away.
+    """
+    term_weights = []
+    for problem in generated:
+        fields = {
+            "title": problem["title"],
+            "concepts": " ".join(problem["concepts"]),
+            "code": CODE_NOISE_PATTERN.sub(" ", problem["code"]),
+            "explanation": problem["explanation"],
+        }
+        weights = {}
+        for field, text in fields.items():
+            tf = {}
+            for token in search_tokens(text):
+                tf[token] = tf.get(token, 0) + 1
+            for token, count in tf.items():
+                weights[token] = weights.get(token, 0) + SEARCH_FIELD_WEIGHTS[field] * min(
+                    count, SEARCH_MAX_TF
+                )
+        best = sorted(weights.items(), key=lambda kv: (-kv[1], kv[0]))
+        term_weights.append(dict(best[:SEARCH_MAX_TERMS_PER_PROBLEM]))
+
+    postings = {}
+    for pos, weights in enumerate(term_weights):
+        for token, weight in weights.items():
+            postings.setdefault(token, []).append((pos, weight))
+
+    max_df = max(1, int(len(generated) * SEARCH_COMMON_DOC_RATIO))
+    common = sorted(t for t, p in postings.items() if len(p) > max_df)
+    terms = sorted(t for t, p in postings.items() if len(p) <= max_df)
+
+    encoded = []
+    for term in terms:
+        flat = []
+        previous = 0
+        for pos, weight in postings[term]:
+            flat += [pos - previous, weight]
+            previous = pos
+        encoded.append(flat)
+
+    return {
+        "format": 1,
+        "problemIds": [p["id"] for p in generated],
+        "titles": [p["title"] for p in generated],
+        "difficulties": [p["difficulty"] for p in generated],
+        "common": common,
+        "terms": terms,
+        "postings": encoded,
+    }
+
+def write_asset(path: pathlib.Path, data, served: bool = True) -> str:
+    """
+    Write minified JSON plus, for files `served` as they are (`web/public/`), precompressed .gz
+    (and .br when available) siblings. The files of `web/data/` are only read by the build.
+    """
+    raw = json.dumps(data, ensure_ascii=False, separators=(",", ":")).encode("utf-8")
+    path.write_bytes(raw)
+
+    sizes = [f"{len(raw) / 1024:.1f} KB"]
+    if not served:
+        for suffix in (".gz", ".br"):
+            path.with_name(path.name + suffix).unlink(missing_ok=True)
+        return f"{path.relative_to(ROOT)} ({sizes[0]})"
+    compressed = gzip.compress(raw, compresslevel=9, mtime=0)
+    path.with_name(path.name + ".gz").write_bytes(compressed)
+    sizes.append(f"gz {len(compressed) / 1024:.1f} KB")
+    if brotli is not None:
+        compressed = brotli.compress(raw, quality=11)
+        path.with_name(path.name + ".br").write_bytes(compressed)
+        sizes.append(f"br {len(compressed) / 1024:.1f} KB")
+
+    return f"{path.relative_to(ROOT)} ({', '.join(sizes)})"
+
+def load_problems():
     with open(PROBLEMS_JSON, "r", encoding="utf-8") as f:
         problems = json.load(f)
+    for problem in problems:
+        if problem.get("answerMode", "output") not in ANSWER_MODES:
+            raise SystemExit(f"{problem['id']}: unknown answerMode {problem['answerMode']!r}")
+        if problem.get("answerMode") == "optimization":
+            question = problem.get("optimization") or {}
+            if question.get("pass") not in ("vectorize", "inline") or "line" not in question:
+                raise SystemExit(
+                    f"{problem['id']}: optimization needs a pass (vectorize|inline) and a line"
+                )
+        layout = problem.get("layout")
+        if layout is not None or problem.get("answerMode") == "layout":
+            members = [name for names in (layout or {}).values() for name in names]
+            if not layout or not all(layout.values()) or not all(
+                LAYOUT_NAME_PATTERN.fullmatch(name) for name in [*layout, *members]
+            ):
+                raise SystemExit(
+                    f"{problem['id']}: layout needs structs, each with its data members"
+                )
+        concurrency = problem.get("concurrency")
+        if concurrency is not None or problem.get("answerMode") == "outputs":
+            concurrency = concurrency or {}
+            choices = concurrency.get("choices")
+            if (
+                not isinstance(concurrency.get("runs", DEFAULT_SCHEDULE_RUNS), int)
+                or concurrency.get("runs", DEFAULT_SCHEDULE_RUNS) < 1
+                or (problem.get("answerMode") == "outputs" and not choices)
+                or not all(isinstance(choice, str) for choice in choices or [])
+            ):
+                raise SystemExit(
+                    f"{problem['id']}: concurrency needs runs >= 1 and, to ask for the possible "
+                    "outputs, the candidate stdouts in choices"
+                )
+        compile_time = problem.get("compileTime")
+        if compile_time is not None or problem.get("answerMode") == "compileTime":
+            compile_time = compile_time or {}
+            variants = compile_time.get("variants")
+            repeat = compile_time.get("repeat", DEFAULT_COMPILE_TIME_REPEAT)
+            if (
+                not isinstance(variants, list)
+                or len(variants) < 2
+                or not all(isinstance(label, str) and label for label in variants)
+                or not isinstance(repeat, int)
+                or repeat < 1
+            ):
+                raise SystemExit(
+                    f"{problem['id']}: compileTime needs the labels of at least two variants "
+                    "(GTO_VARIANT=0, 1, ...) and repeat >= 1"
+                )
+        if problem.get("heapTimeline", True) is not True:
+            raise SystemExit(f"{problem['id']}: heapTimeline is true or absent")
+    return problems
 
-    generated = []
-    problem_index = []
+def compile_problem(problem):
+    """Compile stage: the `make` process (None on timeout) and whether the binary was rebuilt."""
+    binary = BIN_DIR / problem["id"]
+    before = binary.stat().st_mtime_ns if binary.exists() else None
+    proc = run_command(MAKE_CMD + ["problem", f"NAME={problem['id']}"])
+    after = binary.stat().st_mtime_ns if binary.exists() else None
+    return proc, before is None or after != before
 
-    for problem in problems:
-        pid = problem["id"]
-        print(f"[+] Processing {pid}")
-
-        # ----------------------
-        # Compile
-        # ----------------------
-        compile_proc = run_command(
-            MAKE_CMD + ["problem", f"NAME={pid}"]
+def wants_remarks(problem, opt_report: bool) -> bool:
+    return opt_report or problem.get("answerMode") == "optimization"
+
+def compile_remarks(problem):
+    """Optimizer remarks of a problem that compiles (a second, report-only compile)."""
+    proc = run_command(MAKE_CMD + ["remarks", f"NAME={problem['id']}"])
+    if proc is None or proc.returncode != 0:
+        return None
+    return parse_remarks(proc.stderr, problem["id"])
+
+def compile_artifacts(problem, options):
+    """
+    What a problem that compiles gives besides its binary, depending on the problem and on the
+    `options` of the command line: optimizer remarks, assembly listings, record layouts.
+    """
+    artifacts = {}
+    if wants_remarks(problem, options.opt_report):
+        artifacts["remarks"] = compile_remarks(problem)
+    if options.asm:
+        artifacts["asm"] = compile_asm(problem)
+    if problem.get("layout"):
+        artifacts["layout"] = compile_layout(problem, options.layout_bench)
+    return artifacts
+
+def needs_run(problem, compile_proc) -> bool:
+    """Whether the run stage has work: a plain run or a heap timeline."""
+    if compile_proc is None or compile_proc.returncode != 0:
+        return False
+    return not problem.get("UB", False) or "heapTimeline" in problem
+
+def run_problem(problem):
+    """Run stage (once compiled): the `make` process (None on timeout) and the tracer counts."""
+    trace_path = BIN_DIR / f"{problem['id']}.trace"
+    trace_path.unlink(missing_ok=True)
+    proc = run_command(
+        MAKE_CMD + ["run", f"NAME={problem['id']}"],
+        stdin=problem.get("stdin", ""),
+        env={**os.environ, "GTO_TRACE_FILE": str(trace_path)},
+    )
+    return proc, read_trace(trace_path)
+
+def problem_result(problem, compile_proc, run_proc, trace=None, artifacts=None):
+    """
+    Returns the problem enriched with its code and the result of its stages. `artifacts` are what
+    the compile stage got from the source besides the binary (see `compile_artifacts`).
+    """
+    artifacts = artifacts or {}
+    remarks = artifacts.get("remarks")
+    pid = problem["id"]
+
+    result = None
+    if problem.get("UB", False):
+        result = {
+            "errorType": "undefined-behavior",
+        }
+    elif compile_proc is None:
+        result = {
+            "errorType": "compilation-error",
+            "errorMessage": ansi_to_tokens("Compilation timed out")
+        }
+    elif compile_proc.returncode != 0:
+        result = {
+            "errorType": "compilation-error",
+            "errorMessage": ansi_to_tokens(strip_make_error_line(compile_proc.stderr.strip()))
+        }
+    elif run_proc is None:
+        result = {
+            "errorType": "runtime-error",
+            "errorMessage": ansi_to_tokens("Execution timed out")
+        }
+    elif run_proc.returncode != 0:
+        result = {
+            "errorType": "runtime-error",
+            "errorMessage": ansi_to_tokens(strip_make_error_line(run_proc.stderr.strip()))
+        }
+    else:
+        clean_stdout = strip_runner_line(
+            run_proc.stdout, pid
         )
-        result = None
-        if problem.get("UB", False):
-            result = {
-                "errorType": "undefined-behavior",
-            }
-        elif compile_proc is None:
-            result = {
-                "errorType": "compilation-error",
-                "errorMessage": ansi_to_tokens("Compilation timed out")
-            }
-        elif compile_proc.returncode != 0:
-            result = {
-                "errorType": "compilation-error",
-                "errorMessage": ansi_to_tokens(strip_make_error_line(compile_proc.stderr.strip()))
-            }
+        result = {
+            "errorType": "no-error",
+            "stdout": clean_stdout
+        }
+
+    if result.get("errorMessage"):
+        result["errorSections"] = diagnostic_sections(result["errorMessage"])
+
+    if trace and "lifecycle" in trace:
+        result["lifecycle"] = {name: trace["lifecycle"].get(name, 0) for name in LIFECYCLE_COUNTERS}
+    elif problem.get("answerMode") == "lifecycle" and result["errorType"] == "no-error":
+        print(f"[!] {pid}: answerMode is lifecycle but no counts were traced (gto::Traced unused?)")
+
+    if artifacts.get("layout"):
+        result["layout"] = artifacts["layout"]
+    elif problem.get("answerMode") == "layout" and result["errorType"] != "compilation-error":
+        print(f"[!] {pid}: answerMode is layout but the layout probe failed")
+
+    schedules = artifacts.get("schedules")
+    if schedules:
+        result["schedules"] = schedules
+        observed = [output["stdout"] for output in schedules["outputs"]]
+        choices = problem["concurrency"].get("choices") or []
+        if problem.get("answerMode") == "outputs" and schedules["races"]:
+            print(f"[!] {pid}: answerMode is outputs but ThreadSanitizer reports a race (UB?)")
+        if choices and any(output not in choices for output in observed):
+            print(f"[!] {pid}: observed outputs missing from concurrency.choices: {observed}")
+    elif problem.get("answerMode") == "outputs" and result["errorType"] != "compilation-error":
+        print(f"[!] {pid}: answerMode is outputs but no schedule was explored")
+
+    if artifacts.get("compileTime"):
+        result["compileTime"] = artifacts["compileTime"]
+    elif problem.get("answerMode") == "compileTime" and result["errorType"] != "compilation-error":
+        print(f"[!] {pid}: answerMode is compileTime but the variants were not timed")
+
+    if artifacts.get("coverage"):
+        result["coverage"] = artifacts["coverage"]
+
+    heap = artifacts.get("heap")
+    if heap:
+        result["heap"] = {"events": heap["events"], "truncated": heap["truncated"]}
+        # The events are placed by line of output: both runs must print the same.
+        if result["errorType"] == "no-error" and heap["stdout"] != result["stdout"]:
+            print(f"[!] {pid}: the heap timeline run printed another output")
+
+    if remarks:
+        result["remarks"] = remarks
+    if problem.get("answerMode") == "optimization" and result["errorType"] != "compilation-error":
+        result["optimized"] = optimization_verdict(problem, remarks)
+        if result["optimized"] is None:
+            print(f"[!] {pid}: no {problem['optimization']['pass']} remark on the asked line")
+
+    generated_problem = dict(problem)
+    generated_problem["result"] = result
+    if artifacts.get("asm"):
+        generated_problem["asm"] = artifacts["asm"]
+    generated_problem["code"] = (PROBLEMS_SRC / f"{pid}.cpp").read_text()
+    return generated_problem
+
+# ----------------------
+# Scheduling
+# ----------------------
+# Compiles and runs are separate jobs sharing `--jobs` workers. Compiles are queued longest
+# first on the historical costs (LPT), and a run is queued as soon as its compile is done, ahead
+# of the remaining compiles: runs fill in between compiles and the tail is made of short jobs.
+# Schedule explorations and compile timings come last, alone on the machine: an exploration runs
+# `--jobs` seeds at once itself, and concurrent jobs would skew the compile timings.
+
+def compile_job(index, problem, costs):
+    return (COMPILE_STAGE, -problem_cost(problem, costs), problem["id"], index)
+
+def run_job(index, problem, costs):
+    return (RUN_STAGE, -stage_costs(problem, costs)[1], problem["id"], index)
+
+def predict_makespan(problems, costs, jobs: int, ordered=False) -> float:
+    """
+    Replay the schedule of `generate_all` with the historical costs: its expected wall time.
+    `ordered` replays compiles in `problems.json` order instead (the sequential runner's order).
+    """
+    queue = [
+        (COMPILE_STAGE, index, "", index) if ordered else compile_job(index, problem, costs)
+        for index, problem in enumerate(problems)
+    ]
+    heapq.heapify(queue)
+    running = []  # (finish time, stage, problem index)
+    clock = 0.0
+    while queue or running:
+        while queue and len(running) < jobs:
+            stage, _, _, index = heapq.heappop(queue)
+            compile_seconds, run_seconds = stage_costs(problems[index], costs)
+            duration = compile_seconds if stage == COMPILE_STAGE else run_seconds
+            heapq.heappush(running, (clock + duration, stage, index))
+        clock, stage, index = heapq.heappop(running)
+        if stage == COMPILE_STAGE and stage_costs(problems[index], costs)[1] > 0:
+            heapq.heappush(queue, run_job(index, problems[index], costs))
+    return clock + sum(schedules_cost(problem, costs) for problem in problems)
+
+def generate_all(problems, costs, jobs: int, options):
+    """
+    Compile and run `problems` on `jobs` workers (see Scheduling), with the artifacts selected by
+    `options` (see `compile_artifacts`). Returns the generated problems in input order and the
+    measured cost of their stages, in seconds.
+    """
+    queue = [compile_job(index, problem, costs) for index, problem in enumerate(problems)]
+    heapq.heapify(queue)
+    compiled = {}
+    later = {}  # concurrency and compile-time problems, finished once every other job is done
+    generated = [None] * len(problems)
+    measured = {}
+    state = {"pending": len(problems), "error": None}
+    ready = threading.Condition()
+
+    def finish(index, compile_proc, artifacts, run_proc=None, trace=None):
+        compiled_ok = compile_proc is not None and compile_proc.returncode == 0
+        if compiled_ok and ("concurrency" in problems[index] or "compileTime" in problems[index]):
+            later[index] = (compile_proc, artifacts, run_proc, trace)
         else:
-            # ----------------------
-            # Run
-            # ----------------------
-            stdin = problem.get("stdin", "")
-            run_proc = run_command(
-                MAKE_CMD + ["run", f"NAME={pid}"],
-                stdin=stdin
+            generated[index] = problem_result(
+                problems[index], compile_proc, run_proc, trace, artifacts
             )
+        with ready:
+            state["pending"] -= 1
+            ready.notify_all()
 
-            if run_proc is None:
-                result = {
-                    "errorType": "runtime-error",
-                    "errorMessage": ansi_to_tokens("Execution timed out")
-                }
-            elif run_proc.returncode != 0:
-                result = {
-                    "errorType": "runtime-error",
-                    "errorMessage": strip_make_error_line(run_proc.stderr.strip())
-                }
-            else:
-                clean_stdout = strip_runner_line(
-                    run_proc.stdout, pid
-                )
-                result = {
-                    "errorType": "no-error",
-                    "stdout": clean_stdout
-                }
-
-        generated_problem = dict(problem)
-        generated_problem["result"] = result
-        generated_problem["code"] = (PROBLEMS_SRC / f"{problem["id"]}.cpp").read_text()
-        generated.append(generated_problem)
-        problem_index.append({
-            "id": generated_problem["id"],
-            "difficulty": generated_problem["difficulty"],
-            "concepts": generated_problem["concepts"]
-        })
+    def worker():
+        while True:
+            with ready:
+                while not queue and state["pending"] and not state["error"]:
+                    ready.wait()
+                if not queue or state["error"]:
+                    return
+                stage, _, pid, index = heapq.heappop(queue)
+
+            problem = problems[index]
+            try:
+                start = time.perf_counter()
+                if stage == COMPILE_STAGE:
+                    print(f"[+] Processing {pid}", flush=True)
+                    compile_proc, rebuilt = compile_problem(problem)
+                    compiled_ok = compile_proc is not None and compile_proc.returncode == 0
+                    artifacts = compile_artifacts(problem, options) if compiled_ok else {}
+                    # The whole stage, artifacts included: it is what the costs schedule. An
+                    # up-to-date binary says nothing about the compile time: keep the history.
+                    seconds = round(time.perf_counter() - start, 3)
+                    measured[pid] = {
+                        "compile": seconds if rebuilt else stage_costs(problem, costs)[0],
+                        "run": 0.0,
+                    }
+                    if needs_run(problem, compile_proc):
+                        compiled[pid] = (compile_proc, artifacts)
+                        with ready:
+                            heapq.heappush(queue, run_job(index, problem, costs))
+                            ready.notify()
+                    else:
+                        finish(index, compile_proc, artifacts)
+                else:
+                    compile_proc, artifacts = compiled.pop(pid)
+                    run_proc, trace = None, None
+                    if not problem.get("UB", False):
+                        run_proc, trace = run_problem(problem)
+                        # An abort loses the counts (written at exit): successful runs only.
+                        if options.coverage and run_proc and run_proc.returncode == 0:
+                            artifacts["coverage"] = line_coverage(problem)
+                    if "heapTimeline" in problem:
+                        artifacts["heap"] = heap_timeline(problem)
+                    # The whole stage too: coverage and heap timeline included.
+                    measured[pid]["run"] = round(time.perf_counter() - start, 3)
+                    finish(index, compile_proc, artifacts, run_proc, trace)
+            except BaseException as error:
+                with ready:
+                    state["error"] = error
+                    ready.notify_all()
+                return
+
+    threads = [threading.Thread(target=worker) for _ in range(min(jobs, len(problems)))]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    if state["error"]:
+        raise state["error"]
+
+    # Alone on the machine (see Scheduling).
+    for index, (compile_proc, artifacts, run_proc, trace) in sorted(later.items()):
+        problem = problems[index]
+        if "concurrency" in problem:
+            print(f"[+] Exploring the schedules of {problem['id']}", flush=True)
+            start = time.perf_counter()
+            artifacts["schedules"] = explore_schedules(problem, jobs)
+            measured[problem["id"]]["schedules"] = round(time.perf_counter() - start, 3)
+        if "compileTime" in problem:
+            print(f"[+] Timing the compile of {problem['id']}", flush=True)
+            artifacts["compileTime"] = measure_compile_time(problem)
+        generated[index] = problem_result(problem, compile_proc, run_proc, trace, artifacts)
+    return generated, measured
+
+def generate_timed(problems, costs, jobs: int, options):
+    """`generate_all`, reporting its wall time against the predicted one."""
+    predicted = predict_makespan(problems, costs, jobs)
+    in_order = predict_makespan(problems, costs, jobs, ordered=True)
+    start = time.perf_counter()
+    generated, measured = generate_all(problems, costs, jobs, options)
+    print(
+        f"[+] {len(problems)} problems on {jobs} jobs in {time.perf_counter() - start:.1f}s "
+        f"(predicted {predicted:.1f}s, {in_order:.1f}s in problems.json order)"
+    )
+    return generated, measured
+
+def filesystem_type(path: pathlib.Path) -> str:
+    """Type of the filesystem `path` is on (its longest mount point in /proc/mounts)."""
+    resolved = str(path.resolve())
+    best, fstype = "", "unknown"
+    for entry in pathlib.Path("/proc/mounts").read_text(encoding="utf-8").splitlines():
+        _, mount_point, kind = entry.split()[:3]
+        inside = resolved == mount_point or resolved.startswith(mount_point.rstrip("/") + "/")
+        if inside and len(mount_point) >= len(best):
+            best, fstype = mount_point, kind
+    return fstype
+
+def ram_directory() -> pathlib.Path:
+    """A new private (0700) directory on a RAM-backed filesystem; exits if there is none."""
+    for candidate in RAM_DIR_CANDIDATES:
+        if candidate and os.path.isdir(candidate) and os.access(candidate, os.W_OK):
+            if filesystem_type(pathlib.Path(candidate)) in RAM_FILESYSTEMS:
+                return pathlib.Path(tempfile.mkdtemp(prefix="gto-", dir=candidate))
+    raise SystemExit(f"[!] no writable tmpfs among {[c for c in RAM_DIR_CANDIDATES if c]}")
+
+def use_bin_dir(path: pathlib.Path):
+    """Build and run in `path` from now on: the Makefile's BIN_DIR, probes, traces, temporaries."""
+    global BIN_DIR, MAKE_CMD
+    BIN_DIR = path.resolve()
+    MAKE_CMD = ["make", f"BIN_DIR={BIN_DIR}"]
+    if filesystem_type(BIN_DIR) in RAM_FILESYSTEMS:
+        os.environ["TMPDIR"] = str(BIN_DIR)
+
+def bench_build(problems, costs, jobs: int, options, repeat: int):
+    """
+    Cold builds of every problem (`generate_all` on an empty BIN_DIR) on disk, in a new directory
+    of `build/`, against a new directory on tmpfs, alternated `repeat` times. Writes nothing else.
+    """
+    disk_tmpdir = os.environ.get("TMPDIR")
+    modes = {
+        "disk": lambda: pathlib.Path(tempfile.mkdtemp(prefix="bench-", dir=BUILD_DIR)),
+        "tmpfs": ram_directory,
+    }
+    BUILD_DIR.mkdir(parents=True, exist_ok=True)
+    seconds = {mode: [] for mode in modes}
+    for round_ in range(repeat):
+        # Alternate which mode goes first: the second one finds warmer caches.
+        for mode in sorted(modes, reverse=round_ % 2 == 1):
+            directory = modes[mode]()
+            use_bin_dir(directory)
+            try:
+                start = time.perf_counter()
+                generate_all(problems, costs, jobs, options)
+                seconds[mode].append(time.perf_counter() - start)
+            finally:
+                shutil.rmtree(directory, ignore_errors=True)
+                os.environ.pop("TMPDIR", None)
+                if disk_tmpdir is not None:
+                    os.environ["TMPDIR"] = disk_tmpdir
+            print(f"[+] round {round_ + 1}/{repeat}, {mode}: {seconds[mode][-1]:.1f}s", flush=True)
+
+    for mode, samples in seconds.items():
+        print(
+            f"[+] {mode:5}: median {statistics.median(samples):.1f}s, "
+            f"min {min(samples):.1f}s over {repeat} cold builds of {len(problems)} problems"
+        )
+    ratio = statistics.median(seconds["disk"]) / statistics.median(seconds["tmpfs"])
+    print(f"[+] tmpfs is {ratio:.2f}x the speed of disk ({filesystem_type(BUILD_DIR)})")
+
+def write_asm_listings(generated):
+    """
+    Move the assembly listings out of the problems into `OUTPUT_ASM_DIR`, fetched by the review
+    panel only when opened: one file per distinct listing, named by the hash of its content, which
+    replaces the listing in the problem. Files no problem references anymore are removed.
+    """
+    OUTPUT_ASM_DIR.mkdir(parents=True, exist_ok=True)
+    written = {}
+    problems = []
+    for problem in generated:
+        listing = problem.get("asm")
+        if listing:
+            raw = json.dumps(listing, ensure_ascii=False, separators=(",", ":")).encode("utf-8")
+            digest = hashlib.sha256(raw).hexdigest()[:16]
+            if digest not in written:
+                path = OUTPUT_ASM_DIR / f"{digest}.json"
+                write_asset(path, listing)
+                written[digest] = path.stat().st_size
+            problem = {**problem, "asm": digest}
+        problems.append(problem)
+
+    for path in OUTPUT_ASM_DIR.iterdir():
+        if path.name.split(".")[0] not in written:
+            path.unlink()
+    print(
+        f"[+] Assembly listings: {len(written)} files for "
+        f"{sum(1 for p in problems if p.get('asm'))} problems, "
+        f"{sum(written.values()) / 1024:.1f} KB in {OUTPUT_ASM_DIR.relative_to(ROOT)}"
+    )
+    return problems
+
+def write_outputs(generated):
+    """Write every web asset derived from the generated problems (in `problems.json` order)."""
+    generated = write_asm_listings(generated)
+    problem_index = [
+        {"id": p["id"], "difficulty": p["difficulty"], "concepts": p["concepts"]}
+        for p in generated
+    ]
 
     OUTPUT_JSON.parent.mkdir(parents=True, exist_ok=True)
-    with open(OUTPUT_JSON, "w", encoding="utf-8") as f:
-        json.dump(generated, f, indent=2)
-    with open(OUTPUT_JSON_INDEX, "w", encoding="utf-8") as f:
-        json.dump(problem_index, f, indent=2)
+    written = [
+        write_asset(OUTPUT_JSON, generated, served=False),
+        write_asset(OUTPUT_JSON_COMPACT, encode_compact(generated), served=False),
+        write_asset(OUTPUT_JSON_FACETS, build_facets(problem_index), served=False),
+    ]
+
+    search_index = build_search_index(generated)
+    OUTPUT_SEARCH_INDEX.parent.mkdir(parents=True, exist_ok=True)
+    written.append(write_asset(OUTPUT_SEARCH_INDEX, search_index))
+    print(
+        f"[+] Search index: {len(search_index['terms'])} terms, "
+        f"{sum(len(p) // 2 for p in search_index['postings'])} postings, "
+        f"{len(search_index['common'])} common terms left out"
+    )
+
+    print("\n✔ Generated:\n  " + "\n  ".join(written))
+
+# ----------------------
+# Sharding
+# ----------------------
+
+def load_costs(path: pathlib.Path):
+    try:
+        return json.loads(path.read_text(encoding="utf-8"))
+    except (FileNotFoundError, json.JSONDecodeError):
+        return {}
 
-    print(f"\n✔ Generated {OUTPUT_JSON}, {OUTPUT_JSON_INDEX}")
+def save_costs(path: pathlib.Path, costs):
+    path.parent.mkdir(parents=True, exist_ok=True)
+    path.write_text(json.dumps(dict(sorted(costs.items())), indent=2) + "\n", encoding="utf-8")
+
+def stage_costs(problem, costs):
+    """
+    (compile, run) seconds: last measured, else an estimate from the source size (same on every
+    machine). Costs files written before the stages were timed apart hold one total per problem.
+    """
+    pid = problem["id"]
+    cost = costs.get(pid)
+    if isinstance(cost, dict):
+        return cost["compile"], cost["run"]
+    if cost is not None:
+        return cost, 0.0
+    source = PROBLEMS_SRC / f"{pid}.cpp"
+    size_kb = source.stat().st_size / 1024 if source.exists() else 1
+    estimate = ESTIMATED_COMPILE_SECONDS + ESTIMATED_SECONDS_PER_SOURCE_KB * size_kb
+    return round(estimate, 3), 0.0
+
+def problem_cost(problem, costs) -> float:
+    return round(sum(stage_costs(problem, costs)), 3)
+
+def schedules_cost(problem, costs) -> float:
+    """Seconds of the schedule exploration, after the other jobs (see Scheduling), last measured."""
+    cost = costs.get(problem["id"])
+    return cost.get("schedules", 0.0) if isinstance(cost, dict) else 0.0
+
+def plan_shards(problems, costs, count: int):
+    """
+    Longest-processing-time-first: problems by decreasing cost, each to the least loaded shard.
+    Deterministic (ties broken by id, then shard number), so every runner computes the same plan
+    from the same `problems.json` and costs file. Returns the problem ids of each shard.
+    """
+    loads = [0.0] * count
+    shards = [[] for _ in range(count)]
+    def cost(problem):
+        return problem_cost(problem, costs) + schedules_cost(problem, costs)
+
+    ranked = sorted(problems, key=lambda p: (-cost(p), p["id"]))
+    for problem in ranked:
+        target = min(range(count), key=lambda i: (loads[i], i))
+        loads[target] += cost(problem)
+        shards[target].append(problem["id"])
+    return shards, loads
+
+def plan_fingerprint(shards) -> str:
+    """Identifies a plan: shards of different plans cannot be merged."""
+    digest = hashlib.sha256(PROBLEMS_JSON.read_bytes())
+    digest.update(json.dumps(shards).encode("utf-8"))
+    return digest.hexdigest()[:16]
+
+def parse_shard(text: str):
+    match = re.fullmatch(r"(\d+)/(\d+)", text)
+    if not match or not 1 <= int(match[1]) <= int(match[2]):
+        raise argparse.ArgumentTypeError(f"expected i/N with 1 <= i <= N, got {text!r}")
+    return int(match[1]), int(match[2])
+
+def shard_path(out_dir: pathlib.Path, index: int, count: int) -> pathlib.Path:
+    return out_dir / f"shard-{index}-of-{count}.json"
+
+def generate_shard(problems, index, count, costs_path: pathlib.Path, out_dir, jobs, options):
+    costs = load_costs(costs_path)
+    shards, loads = plan_shards(problems, costs, count)
+    ids = set(shards[index - 1])
+    print(
+        f"[+] Shard {index}/{count}: {len(ids)} of {len(problems)} problems, "
+        f"estimated {loads[index - 1]:.1f}s (shards: {min(loads):.1f}s to {max(loads):.1f}s)"
+    )
+
+    generated, measured = generate_timed(
+        [p for p in problems if p["id"] in ids], costs, jobs, options
+    )
+    partial = {
+        "format": SHARD_FORMAT,
+        "shard": index,
+        "shards": count,
+        "plan": plan_fingerprint(shards),
+        "problems": generated,
+        "costs": measured,
+    }
+    path = shard_path(out_dir, index, count)
+    path.parent.mkdir(parents=True, exist_ok=True)
+    path.write_text(json.dumps(partial, ensure_ascii=False), encoding="utf-8")
+    print(f"\n✔ Partial result: {path.relative_to(ROOT) if path.is_relative_to(ROOT) else path}")
+
+def merge_shards(problems, paths, costs_path: pathlib.Path):
+    """Combine partial results into the outputs of a single-host run, or fail loudly."""
+    if not paths:
+        raise SystemExit(f"No partial results found in {SHARDS_DIR.relative_to(ROOT)}")
+
+    partials = [json.loads(pathlib.Path(p).read_text(encoding="utf-8")) for p in paths]
+    first = partials[0]
+    for partial in partials:
+        if partial.get("format") != SHARD_FORMAT:
+            raise SystemExit(f"Unsupported partial format: {partial.get('format')}")
+        if (partial["shards"], partial["plan"]) != (first["shards"], first["plan"]):
+            raise SystemExit(
+                "Partial results come from different plans (problems.json, costs file or shard "
+                "count differ between runners)"
+            )
+
+    numbers = sorted(partial["shard"] for partial in partials)
+    if numbers != list(range(1, first["shards"] + 1)):
+        raise SystemExit(f"Expected shards 1..{first['shards']}, got {numbers}")
+
+    by_id = {}
+    for partial in partials:
+        for generated_problem in partial["problems"]:
+            if generated_problem["id"] in by_id:
+                raise SystemExit(f"{generated_problem['id']} is in more than one shard")
+            by_id[generated_problem["id"]] = generated_problem
+
+    missing = [p["id"] for p in problems if p["id"] not in by_id]
+    if missing or len(by_id) != len(problems):
+        raise SystemExit(f"Partial results do not match problems.json (missing: {missing[:10]})")
+
+    write_outputs([by_id[p["id"]] for p in problems])
+
+    costs = load_costs(costs_path)
+    for partial in partials:
+        costs.update(partial["costs"])
+    save_costs(costs_path, costs)
+    print(f"[+] Merged {len(partials)} shards, costs saved to {costs_path.name}")
+
+# ----------------------
+# make check
+# ----------------------
+
+def write_stdin_files(problems, out_dir: pathlib.Path):
+    """
+    The stdin of every problem in `out_dir/<id>.stdin` (empty without one), read by `make check`.
+    Unchanged files are left alone, so make only reruns the problems whose stdin changed.
+    """
+    out_dir.mkdir(parents=True, exist_ok=True)
+    written = 0
+    for problem in problems:
+        path = out_dir / f"{problem['id']}.stdin"
+        stdin = problem.get("stdin", "")
+        if not path.exists() or path.read_text(encoding="utf-8") != stdin:
+            path.write_text(stdin, encoding="utf-8")
+            written += 1
+    print(f"[+] stdin of {len(problems)} problems in {out_dir}, {written} written")
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(
+        description="Compile and run every problem, then write the web data.",
+        epilog="Sharded: run `--shard i/N` for i = 1..N (any machines), then `merge`. "
+               "`stdin --out DIR` only writes the stdin files of `make check`. "
+               "`bench-build` times cold builds on disk against tmpfs.",
+    )
+    parser.add_argument(
+        "command", nargs="?", choices=["generate", "merge", "stdin", "bench-build"],
+        default="generate",
+    )
+    parser.add_argument("partials", nargs="*", help="merge: partial results (default: all)")
+    parser.add_argument("--shard", type=parse_shard, help="only generate shard i of N (1-based)")
+    parser.add_argument("--out", type=pathlib.Path, default=SHARDS_DIR,
+                        help="directory of the partial results (stdin: of the .stdin files)")
+    parser.add_argument("--costs", type=pathlib.Path, default=COSTS_JSON,
+                        help="per-problem costs used to schedule jobs and balance shards")
+    parser.add_argument("--jobs", "-j", type=int, default=os.cpu_count() or 1,
+                        help="compiles and runs in parallel (default: number of CPUs)")
+    parser.add_argument("--opt-report", action="store_true",
+                        help="store optimizer remarks (vectorization, inlining) for every problem")
+    parser.add_argument("--no-asm", dest="asm", action="store_false",
+                        help="skip the -O0/-O2 assembly listings of the review panel")
+    parser.add_argument("--layout-bench", action="store_true",
+                        help="time a hot loop over each struct of the layout problems")
+    parser.add_argument("--coverage", action="store_true",
+                        help="store per-line execution counts (gcov) of the problems that run")
+    parser.add_argument("--bin-dir", type=pathlib.Path,
+                        help="binaries, probes and traces (default: build/, with the caches)")
+    parser.add_argument("--in-memory", action="store_true",
+                        help="build and run in a private tmpfs directory, removed at exit")
+    parser.add_argument("--repeat", type=int, default=3,
+                        help="bench-build: cold builds per mode (default: 3)")
+    args = parser.parse_args(argv)
+    if args.jobs < 1:
+        parser.error("--jobs must be at least 1")
+    if args.bin_dir and args.in_memory:
+        parser.error("--bin-dir and --in-memory are exclusive")
+    if args.repeat < 1:
+        parser.error("--repeat must be at least 1")
+
+    problems = load_problems()
+
+    if args.command == "stdin":
+        write_stdin_files(problems, args.out)
+    elif args.command == "merge":
+        paths = args.partials or sorted(args.out.glob("shard-*-of-*.json"))
+        merge_shards(problems, paths, args.costs)
+    elif args.command == "bench-build":
+        bench_build(problems, load_costs(args.costs), args.jobs, args, args.repeat)
+    else:
+        scratch = ram_directory() if args.in_memory else None
+        if scratch or args.bin_dir:
+            use_bin_dir(scratch or args.bin_dir)
+            print(f"[+] Building in {BIN_DIR} ({filesystem_type(BIN_DIR)})")
+        try:
+            if args.shard:
+                generate_shard(problems, *args.shard, args.costs, args.out, args.jobs, args)
+            else:
+                costs = load_costs(args.costs)
+                generated, measured = generate_timed(problems, costs, args.jobs, args)
+                write_outputs(generated)
+                save_costs(args.costs, {**costs, **measured})
+        finally:
+            if scratch:
+                shutil.rmtree(scratch, ignore_errors=True)
 
 
 if __name__ == "__main__":
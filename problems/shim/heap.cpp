@@ -0,0 +1,214 @@
+// Heap timeline of problems with `heapTimeline` (`make heap`).
+//
+// Linked into the problem as it is normally built, it replaces the global `operator new` and
+// `operator delete` (every form) to record each allocation and release as it happens, with the
+// number of lines `std::cout` had written at that point, so that `run_all.py` can line the events
+// up with the output. Blocks are numbered in allocation order. At exit, the events are appended to
+// the file named by `GTO_TRACE_FILE` as `alloc <block> <bytes> <line>` and
+// `free <block> <bytes> <line>` lines, followed by `truncated` if the tables filled up.
+//
+// Nothing here may allocate through `operator new`: the tables are static and the stream buffer
+// wrapping `std::cout` forwards to the original one.
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <streambuf>
+
+namespace {
+
+constexpr int kMaxEvents = 4096;
+constexpr int kMaxLiveBlocks = 1024;
+
+struct Event {
+    bool alloc;
+    long block;
+    std::size_t bytes;
+    long line;
+};
+
+struct LiveBlock {
+    void* address;
+    long block;
+    std::size_t bytes;
+};
+
+Event events[kMaxEvents];
+int eventCount = 0;
+LiveBlock liveBlocks[kMaxLiveBlocks];
+int liveCount = 0;
+long nextBlock = 1;
+long linesWritten = 0;
+bool truncated = false;
+bool recording = true;
+bool busy = false;  // spin lock, for problems that allocate from several threads
+
+void lock() {
+    while (__atomic_exchange_n(&busy, true, __ATOMIC_ACQUIRE)) {
+    }
+}
+
+void unlock() { __atomic_store_n(&busy, false, __ATOMIC_RELEASE); }
+
+void record(bool alloc, long block, std::size_t bytes) {
+    if (eventCount == kMaxEvents) {
+        truncated = true;
+        return;
+    }
+    events[eventCount++] = {alloc, block, bytes, __atomic_load_n(&linesWritten, __ATOMIC_RELAXED)};
+}
+
+void* allocate(std::size_t bytes, std::size_t alignment) {
+    void* address = nullptr;
+    const std::size_t size = bytes == 0 ? 1 : bytes;
+    if (alignment <= alignof(std::max_align_t)) {
+        address = std::malloc(size);
+    } else if (posix_memalign(&address, alignment, size) != 0) {
+        address = nullptr;
+    }
+    if (!address) return nullptr;
+
+    lock();
+    if (recording) {
+        if (liveCount < kMaxLiveBlocks) {
+            liveBlocks[liveCount++] = {address, nextBlock, bytes};
+            record(true, nextBlock++, bytes);
+        } else {
+            truncated = true;
+        }
+    }
+    unlock();
+    return address;
+}
+
+void release(void* address) {
+    if (!address) return;
+    lock();
+    for (int i = liveCount - 1; i >= 0; --i) {
+        if (liveBlocks[i].address == address) {
+            if (recording) record(false, liveBlocks[i].block, liveBlocks[i].bytes);
+            liveBlocks[i] = liveBlocks[--liveCount];
+            break;
+        }
+    }
+    unlock();
+    std::free(address);
+}
+
+void* allocateOrThrow(std::size_t bytes, std::size_t alignment) {
+    for (;;) {
+        if (void* address = allocate(bytes, alignment)) return address;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+// Counts the lines written through `std::cout`, passing everything on unbuffered.
+class LineCountingBuffer : public std::streambuf {
+public:
+    explicit LineCountingBuffer(std::streambuf* target) : target_(target) {}
+
+    std::streambuf* target() const { return target_; }
+
+protected:
+    int_type overflow(int_type c) override {
+        if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+        if (traits_type::to_char_type(c) == '\n') count(1);
+        return target_->sputc(traits_type::to_char_type(c));
+    }
+
+    std::streamsize xsputn(const char* text, std::streamsize size) override {
+        long lines = 0;
+        for (std::streamsize i = 0; i < size; ++i) lines += text[i] == '\n';
+        const std::streamsize written = target_->sputn(text, size);
+        count(lines);
+        return written;
+    }
+
+    int sync() override { return target_->pubsync(); }
+
+private:
+    static void count(long lines) {
+        if (lines) __atomic_fetch_add(&linesWritten, lines, __ATOMIC_RELAXED);
+    }
+
+    std::streambuf* target_;
+};
+
+// Constructed before, so destroyed after, the static objects of the problem: their releases are
+// on the timeline and the output is complete when it is restored.
+class HeapReport {
+public:
+    HeapReport() : buffer_(std::cout.rdbuf()) { std::cout.rdbuf(&buffer_); }
+    HeapReport(const HeapReport&) = delete;
+    HeapReport& operator=(const HeapReport&) = delete;
+
+    ~HeapReport() {
+        std::cout.flush();
+        std::cout.rdbuf(buffer_.target());
+        lock();
+        recording = false;
+        unlock();
+
+        const char* path = std::getenv("GTO_TRACE_FILE");
+        if (!path) return;
+        std::FILE* file = std::fopen(path, "a");
+        if (!file) return;
+        for (int i = 0; i < eventCount; ++i) {
+            const Event& event = events[i];
+            std::fprintf(file, "%s %ld %zu %ld\n", event.alloc ? "alloc" : "free", event.block,
+                         event.bytes, event.line);
+        }
+        if (truncated) std::fputs("truncated\n", file);
+        std::fclose(file);
+    }
+
+private:
+    std::ios_base::Init iostreams_;  // std::cout exists before it is wrapped
+    LineCountingBuffer buffer_;
+};
+
+__attribute__((init_priority(101))) HeapReport heapReport;
+
+}  // namespace
+
+void* operator new(std::size_t bytes) { return allocateOrThrow(bytes, 0); }
+void* operator new[](std::size_t bytes) { return allocateOrThrow(bytes, 0); }
+void* operator new(std::size_t bytes, std::align_val_t alignment) {
+    return allocateOrThrow(bytes, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t bytes, std::align_val_t alignment) {
+    return allocateOrThrow(bytes, static_cast<std::size_t>(alignment));
+}
+void* operator new(std::size_t bytes, const std::nothrow_t&) noexcept {
+    return allocate(bytes, 0);
+}
+void* operator new[](std::size_t bytes, const std::nothrow_t&) noexcept {
+    return allocate(bytes, 0);
+}
+void* operator new(std::size_t bytes, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocate(bytes, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t bytes, std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+    return allocate(bytes, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* address) noexcept { release(address); }
+void operator delete[](void* address) noexcept { release(address); }
+void operator delete(void* address, std::size_t) noexcept { release(address); }
+void operator delete[](void* address, std::size_t) noexcept { release(address); }
+void operator delete(void* address, std::align_val_t) noexcept { release(address); }
+void operator delete[](void* address, std::align_val_t) noexcept { release(address); }
+void operator delete(void* address, std::size_t, std::align_val_t) noexcept { release(address); }
+void operator delete[](void* address, std::size_t, std::align_val_t) noexcept { release(address); }
+void operator delete(void* address, const std::nothrow_t&) noexcept { release(address); }
+void operator delete[](void* address, const std::nothrow_t&) noexcept { release(address); }
+void operator delete(void* address, std::align_val_t, const std::nothrow_t&) noexcept {
+    release(address);
+}
+void operator delete[](void* address, std::align_val_t, const std::nothrow_t&) noexcept {
+    release(address);
+}
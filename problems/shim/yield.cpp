@@ -0,0 +1,70 @@
+// Yield injection for the schedule exploration of concurrency problems (`make sched`).
+//
+// Linked into the problem built with `-finstrument-functions`, which calls the hooks below on
+// every function entry and exit, including the inlined members of `std::atomic`, `std::mutex` and
+// `std::thread`. At each of these points the running thread may yield or sleep briefly, decided
+// by a per-thread generator seeded from `GTO_SEED` (0 or unset: never). `run_all.py` runs the
+// binary with many seeds, so that even on one CPU the threads interleave in many different ways.
+//
+// Nothing here may be instrumented itself: the hooks are `no_instrument_function` and only call
+// C functions and builtins.
+#include <sched.h>
+#include <time.h>
+
+#include <cstdint>
+#include <cstdlib>
+
+namespace {
+
+std::uint64_t baseSeed = 0;
+
+// Before `main`, so before any thread: no race on `baseSeed` for ThreadSanitizer to report.
+__attribute__((constructor, no_instrument_function)) void readSeed() {
+    const char* text = std::getenv("GTO_SEED");
+    baseSeed = text ? std::strtoull(text, nullptr, 10) : 0;
+}
+
+__attribute__((no_instrument_function)) void maybeYield() {
+    thread_local std::uint64_t state = 0;
+    thread_local std::uint64_t pauseOneIn = 0;  // 0: this thread never pauses
+    thread_local bool inside = false;
+    static std::uint64_t threads = 0;
+
+    if (baseSeed == 0 || inside) return;
+    inside = true;
+    if (state == 0) {
+        // Threads get distinct streams in creation order, so a seed names one schedule policy,
+        // and each thread its own pace: some run straight through, others keep pausing.
+        const std::uint64_t thread = __atomic_fetch_add(&threads, 1, __ATOMIC_RELAXED);
+        state = (baseSeed * 0x9E3779B97F4A7C15ull) ^ (thread + 1) * 0xBF58476D1CE4E5B9ull;
+        if (state == 0) state = 1;
+        const std::uint64_t paces[] = {0, 16, 4, 2};
+        pauseOneIn = paces[(state >> 32) % 4];
+    }
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    // A yield alone rarely lets another thread in under CFS; a sleep does.
+    if (pauseOneIn != 0 && state % pauseOneIn == 0) {
+        const timespec pause{0, static_cast<long>((state >> 8) % 500000)};
+        nanosleep(&pause, nullptr);
+    } else if (state % 8 == 1) {
+        sched_yield();
+    }
+    inside = false;
+}
+
+}  // namespace
+
+extern "C" {
+
+__attribute__((no_instrument_function)) void __cyg_profile_func_enter(void*, void*) {
+    maybeYield();
+}
+
+__attribute__((no_instrument_function)) void __cyg_profile_func_exit(void*, void*) {
+    maybeYield();
+}
+
+}
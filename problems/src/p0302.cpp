@@ -0,0 +1,15 @@
+#include <gto/lifecycle.hpp>
+#include <iostream>
+#include <vector>
+
+int main() {
+    std::vector<gto::TracedThrowingMove> v;
+    v.reserve(2);
+
+    v.push_back(1);
+    v.emplace_back(2);
+    v.emplace_back(3);
+
+    for (const auto& t : v) std::cout << t.value;
+    std::cout << "\n";
+}
@@ -0,0 +1,18 @@
+#include <iostream>
+
+[[gnu::noinline]] void add(int* dst, const int* src) {
+    for (int i = 0; i < 64; ++i) dst[i] += src[i];
+}
+
+[[gnu::noinline]] void add_restrict(int* __restrict dst, const int* __restrict src) {
+    for (int i = 0; i < 64; ++i) dst[i] += src[i];
+}
+
+int main() {
+    int a[64] = {}, b[64];
+    for (int i = 0; i < 64; ++i) b[i] = i;
+
+    add(a, b);
+    add_restrict(a, b);
+    std::cout << a[63] << "\n";
+}
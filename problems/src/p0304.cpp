@@ -0,0 +1,17 @@
+#include <iostream>
+
+struct Shape {
+    virtual ~Shape() = default;
+    virtual int sides() const { return 0; }
+};
+
+struct Square : Shape {
+    int sides() const override { return 4; }
+};
+
+int count(const Shape& s) { return s.sides(); }
+
+int main() {
+    Square sq;
+    std::cout << count(sq) << "\n";
+}
@@ -0,0 +1,22 @@
+#include <cstdint>
+#include <iostream>
+
+struct Padded {
+    std::uint8_t flag;
+    std::uint64_t id;
+    std::uint8_t kind;
+    std::uint32_t count;
+};
+
+struct Reordered {
+    std::uint64_t id;
+    std::uint32_t count;
+    std::uint8_t flag;
+    std::uint8_t kind;
+};
+
+int main() {
+    Padded records[4]{};
+    Reordered compact[4]{};
+    std::cout << sizeof records - sizeof compact << '\n';
+}
@@ -0,0 +1,17 @@
+#include <cstdint>
+#include <iostream>
+
+struct alignas(64) Counter {
+    std::uint32_t value;
+};
+
+struct Slot {
+    Counter hits;
+    std::uint8_t tag;
+};
+
+int main() {
+    Slot slots[2]{};
+    slots[1].hits.value = 7;
+    std::cout << slots[1].hits.value + slots[0].tag << '\n';
+}
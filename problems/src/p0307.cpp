@@ -0,0 +1,22 @@
+#include <atomic>
+#include <iostream>
+#include <thread>
+
+std::atomic<int> x{0};
+std::atomic<int> y{0};
+int r1 = 0;
+int r2 = 0;
+
+int main() {
+    std::thread a([] {
+        x.store(1);
+        r1 = y.load();
+    });
+    std::thread b([] {
+        y.store(1);
+        r2 = x.load();
+    });
+    a.join();
+    b.join();
+    std::cout << r1 << ' ' << r2 << '\n';
+}
@@ -0,0 +1,16 @@
+#include <iostream>
+#include <thread>
+
+int hits = 0;
+
+int next(int value) { return value + 1; }
+
+void record() { hits = next(hits); }
+
+int main() {
+    std::thread a(record);
+    std::thread b(record);
+    a.join();
+    b.join();
+    std::cout << hits << '\n';
+}
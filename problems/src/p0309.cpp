@@ -0,0 +1,32 @@
+#include <cstdio>
+#include <utility>
+
+#if GTO_VARIANT == 0
+template <int N>
+struct Triangle {
+    static constexpr long value = N + Triangle<N - 1>::value;
+};
+template <>
+struct Triangle<0> {
+    static constexpr long value = 0;
+};
+template <int... Ns>
+constexpr long total(std::integer_sequence<int, Ns...>) {
+    return (Triangle<Ns>::value + ...);
+}
+#else
+constexpr long triangle(int n) {
+    long s = 0;
+    for (int i = 1; i <= n; ++i) s += i;
+    return s;
+}
+template <int... Ns>
+constexpr long total(std::integer_sequence<int, Ns...>) {
+    return (triangle(Ns) + ...);
+}
+#endif
+
+int main() {
+    constexpr long t = total(std::make_integer_sequence<int, 800>{});
+    std::printf("%ld\n", t);
+}
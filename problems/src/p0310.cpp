@@ -0,0 +1,13 @@
+#if GTO_VARIANT == 0
+#include <iostream>
+
+int main() {
+    std::cout << "hello " << 42 << '\n';
+}
+#else
+#include <cstdio>
+
+int main() {
+    std::printf("hello %d\n", 42);
+}
+#endif
@@ -0,0 +1,51 @@
+// DiffText rendering: the baseline component (bench/baseline/DiffText.tsx) vs run-length spans.
+import { createElement as h } from "react";
+import { renderToStaticMarkup } from "react-dom/server";
+
+import { buildDiffRuns, DiffRunsView } from "@/components/sections/problem/DiffText";
+import { diffText } from "@/lib/diff";
+
+import { DiffText as BaselineDiffText } from "./baseline/DiffText.tsx";
+import { countElements, makeOutput, measure, mutateOutput } from "./harness.mjs";
+
+export const description =
+  "Renders a wrong answer against the expected output (server render). `before` is the " +
+  "baseline component (one token per character, compared by index); `after` diffs and renders " +
+  "runs, `after, spans ready` only renders runs (the diff of long outputs runs in a worker).";
+
+function baselineDiffText(text, expected, showWhitespace) {
+  return h(BaselineDiffText, { text, compareTo: expected, showWhitespace });
+}
+
+function runsDiffText(text, expected, showWhitespace) {
+  return renderedRuns(text, diffText(text, expected), showWhitespace);
+}
+
+function renderedRuns(text, spans, showWhitespace) {
+  return h(DiffRunsView, { runs: buildDiffRuns(text, spans, showWhitespace) });
+}
+
+export default function run() {
+  const rows = [];
+
+  for (const size of [1024, 10 * 1024]) {
+    const expected = makeOutput(size);
+    const answer = mutateOutput(expected);
+    const spans = diffText(answer, expected);
+
+    for (const [variant, render] of [
+      ["before", () => baselineDiffText(answer, expected, true)],
+      ["after", () => runsDiffText(answer, expected, true)],
+      ["after, spans ready", () => renderedRuns(answer, spans, true)],
+    ]) {
+      const html = renderToStaticMarkup(render());
+      const timing = measure(() => renderToStaticMarkup(render()));
+      rows.push({
+        name: `${size / 1024} KB ${variant}`,
+        metrics: { elements: countElements(html), ...timing },
+      });
+    }
+  }
+
+  return rows;
+}
@@ -0,0 +1,67 @@
+// ErrorMessageView mount: every span at once (before) vs grouped, collapsed and windowed.
+import { createElement as h } from "react";
+import { renderToStaticMarkup } from "react-dom/server";
+
+import { ErrorMessageView } from "@/components/sections/problem/ErrorMessageView";
+
+import { countElements, measure } from "./harness.mjs";
+
+export const description =
+  "Synthetic template backtraces: N errors, each with 6 lines of instantiation context, a " +
+  "3-line excerpt and 4 lines of notes (server render, elements = DOM nodes at mount).";
+
+const STYLES = ["normal", "bold"];
+
+/** GCC-like output with the structure `diagnostic_sections` (run_all.py) would emit for it. */
+function makeDiagnostics(errors) {
+  const message = [];
+  const sections = [];
+  const line = (text, color = "default", style = "normal") =>
+    message.push({ color, style, text: `${text}\n` });
+
+  for (let e = 0; e < errors; e++) {
+    line(` In instantiation of ‘struct S<${e}>’:`);
+    for (let i = 0; i < 5; i++) line(`${10 + i}:5:   required from ‘struct S<${e + i + 1}>’`);
+    sections.push({ kind: "backtrace", lines: 6 });
+
+    line(`12:7: error: no member named ‘value’ in ‘T${e}’`, "red", STYLES[e % 2]);
+    line(`   12 |   using type = typename T::value;`);
+    line(`      |                         ^~~~~`, "green");
+    sections.push({ kind: "error", lines: 3 });
+
+    line(`4:8: note: ‘T${e}’ declared here`, "cyan");
+    line(`    4 | struct T${e} {};`);
+    line(`      |        ^~`, "green");
+    line(`4:8: note: candidate expects 1 argument, 0 provided`, "cyan");
+    sections.push({ kind: "note", lines: 4 });
+  }
+  return { message, sections };
+}
+
+/** Former implementation: one span per part, all rendered. */
+function legacyView(message) {
+  return h(
+    "div",
+    { role: "note" },
+    message.map((part, i) => h("span", { key: i, className: part.color }, part.text))
+  );
+}
+
+export default function run() {
+  return [10, 100, 1000].flatMap((errors) => {
+    const { message, sections } = makeDiagnostics(errors);
+    const before = () => renderToStaticMarkup(legacyView(message));
+    const after = () => renderToStaticMarkup(h(ErrorMessageView, { message, sections }));
+
+    return [
+      {
+        name: `before: ${errors} errors`,
+        metrics: { ...measure(before, { iterations: 20 }), elements: countElements(before()) },
+      },
+      {
+        name: `after: ${errors} errors`,
+        metrics: { ...measure(after, { iterations: 20 }), elements: countElements(after()) },
+      },
+    ];
+  });
+}
@@ -0,0 +1,54 @@
+// Tiny timing helpers shared by the benchmarks.
+import { performance } from "node:perf_hooks";
+
+/**
+ * Run `fn` `warmup` times, then time `iterations` runs.
+ * Returns milliseconds statistics (median and p95 are what reports should quote).
+ */
+export function measure(fn, { iterations = 50, warmup = 10 } = {}) {
+  for (let i = 0; i < warmup; i++) fn();
+
+  const samples = [];
+  for (let i = 0; i < iterations; i++) {
+    const t0 = performance.now();
+    fn();
+    samples.push(performance.now() - t0);
+  }
+
+  samples.sort((a, b) => a - b);
+  const at = (q) => samples[Math.min(samples.length - 1, Math.floor(q * samples.length))];
+  return {
+    medianMs: round(at(0.5)),
+    p95Ms: round(at(0.95)),
+    meanMs: round(samples.reduce((a, b) => a + b, 0) / samples.length),
+  };
+}
+
+export function round(n, digits = 3) {
+  const f = 10 ** digits;
+  return Math.round(n * f) / f;
+}
+
+/** Number of elements in a static HTML string. */
+export function countElements(html) {
+  return (html.match(/<[a-zA-Z]/g) ?? []).length;
+}
+
+/** Deterministic text of roughly `bytes` bytes made of short numbered lines. */
+export function makeOutput(bytes) {
+  let out = "";
+  for (let i = 0; out.length < bytes; i++) {
+    out += `value[${i}] = ${(i * 7919) % 1000} ${i % 3 === 0 ? "fizz" : "buzz"}\n`;
+  }
+  return out;
+}
+
+/** A plausible wrong answer: a few characters dropped, one line changed. */
+export function mutateOutput(text) {
+  const chars = Array.from(text);
+  const mid = Math.floor(chars.length / 2);
+  chars.splice(mid, 12, ..."oops, typo\n");
+  chars.splice(Math.floor(chars.length / 5), 1);
+  chars.splice(Math.floor((chars.length * 4) / 5), 0, "x");
+  return chars.join("");
+}
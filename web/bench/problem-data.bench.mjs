@@ -0,0 +1,44 @@
+// Problem records: former pretty-printed JSON vs the compact encoding (size and parse time).
+import path from "node:path";
+import { readFileSync } from "node:fs";
+import { brotliCompressSync, gzipSync } from "node:zlib";
+
+import { decodeCompactProblems } from "@/lib/problems";
+
+import { measure, round } from "./harness.mjs";
+
+export const description =
+  "Reads web/data/problems.compact.json (run problems/run_all.py first). `before` is the same " +
+  "records in the former format: indent=2 JSON with one {color, style, text} object per span.";
+
+const DATA = path.resolve(import.meta.dirname, "..", "data", "problems.compact.json");
+
+const kb = (n) => round(n / 1024, 1);
+
+function sizes(text) {
+  const bytes = Buffer.from(text, "utf8");
+  return {
+    rawKB: kb(bytes.length),
+    gzipKB: kb(gzipSync(bytes, { level: 9 }).length),
+    brotliKB: kb(brotliCompressSync(bytes).length),
+  };
+}
+
+export default function run() {
+  const compact = readFileSync(DATA, "utf8");
+  const before = JSON.stringify(decodeCompactProblems(JSON.parse(compact)), null, 2);
+
+  return [
+    {
+      name: "before (pretty JSON)",
+      metrics: { ...sizes(before), ...measure(() => JSON.parse(before)) },
+    },
+    {
+      name: "after (compact)",
+      metrics: {
+        ...sizes(compact),
+        ...measure(() => decodeCompactProblems(JSON.parse(compact))),
+      },
+    },
+  ];
+}
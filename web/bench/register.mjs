@@ -0,0 +1,5 @@
+// Lets benchmarks and tests import the app's TypeScript sources
+// (`node --import ./bench/register.mjs`).
+import { register } from "node:module";
+
+register("./ts-loader.mjs", import.meta.url);
@@ -0,0 +1,26 @@
+// Benchmark runner: `npm run bench [-- <name>...]`.
+const BENCHMARKS = {
+  "diff-text": () => import("./diff-text.bench.mjs"),
+  sampling: () => import("./sampling.bench.mjs"),
+  "problem-data": () => import("./problem-data.bench.mjs"),
+  "store-sync": () => import("./store-sync.bench.mjs"),
+  "error-message": () => import("./error-message.bench.mjs"),
+};
+
+const requested = process.argv.slice(2);
+const names = requested.length > 0 ? requested : Object.keys(BENCHMARKS);
+
+for (const name of names) {
+  const load = BENCHMARKS[name];
+  if (!load) {
+    console.error(`Unknown benchmark "${name}". Available: ${Object.keys(BENCHMARKS).join(", ")}`);
+    process.exit(1);
+  }
+
+  const { default: run, description } = await load();
+  console.log(`\n=== ${name} ===`);
+  if (description) console.log(description);
+
+  const rows = await run();
+  console.table(Object.fromEntries(rows.map((r) => [r.name, r.metrics])));
+}
@@ -0,0 +1,38 @@
+// Session sampling: cost at 100k problems vs the former sort-based shuffle.
+import {
+  createRng,
+  sampleWithoutReplacement,
+  shuffleInPlace,
+  stratifiedSample,
+} from "@/lib/training/sampling";
+
+import { measure } from "./harness.mjs";
+
+export const description = "Timings at n=100k (uniformity: test/sampling.test.mjs).";
+
+export default function run() {
+  const n = 100_000;
+  const positions = Array.from({ length: n }, (_, i) => i);
+  const difficultyOf = (pos) => 1 + (pos % 5);
+  const rng = createRng(2);
+
+  return [
+    {
+      name: "before: sort shuffle, n=100k",
+      // eslint-disable-next-line sonarjs/pseudo-random
+      metrics: measure(() => positions.slice().sort(() => Math.random() - 0.5), { iterations: 10 }),
+    },
+    {
+      name: "after: shuffle, n=100k",
+      metrics: measure(() => shuffleInPlace(positions.slice(), rng), { iterations: 10 }),
+    },
+    {
+      name: "after: draw 20 of 100k",
+      metrics: measure(() => sampleWithoutReplacement(positions, 20, rng)),
+    },
+    {
+      name: "after: stratified 20 of 100k",
+      metrics: measure(() => stratifiedSample(positions, 20, difficultyOf, rng)),
+    },
+  ];
+}
@@ -0,0 +1,82 @@
+// Cross-tab store updates: re-parsing the whole store (former `storage` event path) vs merging
+// the broadcast delta of the one session that changed, and on the writing side, serializing the
+// whole store (former single-key layout) vs the changed session's key.
+import { diffStores, mergeDelta, stampRevisions } from "@/lib/training/sync";
+
+import { measure } from "./harness.mjs";
+
+export const description =
+  "One recorded attempt in a store of N sessions of 20 problems. Sizes are the bytes the " +
+  "receiving tab (parse, merge) or the writing tab (write) handles per update.";
+
+function makeSession(i) {
+  const t = 1_700_000_000_000 + i;
+  return {
+    meta: {
+      id: `ts_${i}`,
+      title: "Training (1-5) • Any concepts",
+      createdAt: t,
+      lastOpenedAt: t,
+      status: "active",
+    },
+    config: { difficultyMin: 1, difficultyMax: 5, concepts: [], problemsPerSession: 20 },
+    problemIds: Array.from({ length: 20 }, (_, j) => `p${String((i + j) % 300).padStart(4, "0")}`),
+    progress: {
+      currentIndex: 3,
+      attemptsOnCurrent: 1,
+      score: { solved: 2, failed: 1, attemptsTotal: 5, correctOnFirstTry: 1 },
+      timers: { sessionSecondsRemaining: null, problemSecondsRemaining: 60, lastTickAt: t },
+      startedAt: t,
+      updatedAt: t,
+    },
+    rev: 4,
+  };
+}
+
+function makeStore(n) {
+  const sessionsById = {};
+  for (let i = 0; i < n; i++) sessionsById[`ts_${i}`] = makeSession(i);
+  return { version: 2, activeSessionId: "ts_0", sessionsById };
+}
+
+function recordAttempt(store) {
+  const s = store.sessionsById.ts_0;
+  const progress = { ...s.progress, attemptsOnCurrent: 2, updatedAt: s.progress.updatedAt + 1 };
+  return { ...store, sessionsById: { ...store.sessionsById, ts_0: { ...s, progress } } };
+}
+
+export default function run() {
+  return [10, 100, 1000].flatMap((n) => {
+    const prev = makeStore(n);
+    const next = stampRevisions(prev, recordAttempt(prev));
+    const raw = JSON.stringify(next);
+    const delta = diffStores(prev, next, "bench");
+    // Structured clone of what BroadcastChannel carries.
+    const message = structuredClone(delta);
+
+    return [
+      {
+        name: `before: parse store, ${n} sessions`,
+        metrics: { ...measure(() => JSON.parse(raw)), bytes: raw.length },
+      },
+      {
+        name: `after: merge delta, ${n} sessions`,
+        metrics: {
+          ...measure(() => mergeDelta(prev, message, new Set())),
+          bytes: JSON.stringify(delta).length,
+        },
+      },
+      {
+        name: `before: write store, ${n} sessions`,
+        metrics: { ...measure(() => JSON.stringify(next)), bytes: raw.length },
+      },
+      {
+        name: `after: write session, ${n} sessions`,
+        metrics: {
+          ...measure(() => delta.upserts.map((session) => JSON.stringify(session))),
+          bytes: JSON.stringify(delta.upserts[0]).length,
+        },
+      },
+    ];
+  });
+}
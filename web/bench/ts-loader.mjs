@@ -0,0 +1,65 @@
+// Minimal ESM loader hooks: resolves the `@/` alias and extensionless imports of `src/`, and
+// transpiles .ts/.tsx on the fly with the project's TypeScript (no type checking). Also used by
+// the tests (`npm test`).
+import path from "node:path";
+import { statSync } from "node:fs";
+import { readFile } from "node:fs/promises";
+import { fileURLToPath, pathToFileURL } from "node:url";
+
+import ts from "typescript";
+
+const SRC_DIR = fileURLToPath(new URL("../src/", import.meta.url));
+const CANDIDATE_SUFFIXES = ["", ".ts", ".tsx", "/index.ts", "/index.tsx"];
+const TS_FILE = /\.tsx?$/;
+
+function isFile(p) {
+  try {
+    return statSync(p).isFile();
+  } catch {
+    return false;
+  }
+}
+
+function resolveSourceFile(base) {
+  for (const suffix of CANDIDATE_SUFFIXES) {
+    if (isFile(base + suffix)) return base + suffix;
+  }
+  return null;
+}
+
+export async function resolve(specifier, context, nextResolve) {
+  let base = null;
+  if (specifier.startsWith("@/")) {
+    base = path.join(SRC_DIR, specifier.slice(2));
+  } else if (
+    (specifier.startsWith("./") || specifier.startsWith("../")) &&
+    context.parentURL &&
+    TS_FILE.test(new URL(context.parentURL).pathname)
+  ) {
+    base = path.resolve(path.dirname(fileURLToPath(context.parentURL)), specifier);
+  }
+
+  const file = base && resolveSourceFile(base);
+  if (file) return { url: pathToFileURL(file).href, shortCircuit: true };
+
+  return nextResolve(specifier, context);
+}
+
+export async function load(url, context, nextLoad) {
+  // The query, if any, is kept in the module URL: `storage.ts?tab=a` is a second instance.
+  if (!TS_FILE.test(new URL(url).pathname)) return nextLoad(url, context);
+
+  const fileName = fileURLToPath(url);
+  const source = await readFile(fileName, "utf8");
+  const { outputText } = ts.transpileModule(source, {
+    fileName,
+    compilerOptions: {
+      module: ts.ModuleKind.ESNext,
+      target: ts.ScriptTarget.ES2022,
+      jsx: ts.JsxEmit.ReactJSX,
+      esModuleInterop: true,
+    },
+  });
+
+  return { format: "module", source: outputText, shortCircuit: true };
+}
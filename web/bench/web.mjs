@@ -0,0 +1,109 @@
+// Frontend benchmark of the static export: `npm run build && npm run bench:web`.
+//
+//   --runs N            browser runs, medians are reported (default 5)
+//   --cpu-throttle N    Chrome CPU slowdown factor (default 1)
+//   --no-browser        only the export sizes
+//   --no-save           do not append to the history
+//   --label TEXT        stored with the result
+//
+// Results are appended to bench/history/web.json and compared with the latest earlier result
+// built from the same corpus (web/data/problems.compact.json).
+import path from "node:path";
+import { createHash } from "node:crypto";
+import { execFileSync } from "node:child_process";
+import { existsSync, readFileSync } from "node:fs";
+import { parseArgs } from "node:util";
+
+import { decodeCompactProblems } from "@/lib/problems";
+
+import { browserMetrics, launchBrowser } from "./web/browser.mjs";
+import { appendHistory, compareResults, loadHistory } from "./web/history.mjs";
+import { routeSizes } from "./web/routes.mjs";
+import { serveStatic } from "./web/server.mjs";
+
+const WEB_DIR = path.resolve(import.meta.dirname, "..");
+const OUT_DIR = path.join(WEB_DIR, "out");
+const CORPUS = path.join(WEB_DIR, "data", "problems.compact.json");
+const HISTORY = path.join(WEB_DIR, "bench", "history", "web.json");
+
+const { values: args } = parseArgs({
+  options: {
+    runs: { type: "string", default: "5" },
+    "cpu-throttle": { type: "string", default: "1" },
+    "no-browser": { type: "boolean", default: false },
+    "no-save": { type: "boolean", default: false },
+    label: { type: "string" },
+  },
+});
+
+if (!existsSync(OUT_DIR) || !existsSync(CORPUS)) {
+  console.error("Missing web/out or web/data: run problems/run_all.py and `npm run build` first.");
+  process.exit(1);
+}
+
+function gitCommit() {
+  try {
+    const commit = execFileSync("git", ["rev-parse", "--short", "HEAD"], { encoding: "utf8" });
+    const dirty = execFileSync("git", ["status", "--porcelain", "--", "src"], { encoding: "utf8" });
+    return `${commit.trim()}${dirty.trim() ? "+dirty" : ""}`;
+  } catch {
+    return null;
+  }
+}
+
+const corpusText = readFileSync(CORPUS, "utf8");
+const result = {
+  at: new Date().toISOString(),
+  commit: gitCommit(),
+  label: args.label ?? null,
+  corpus: createHash("sha256").update(corpusText).digest("hex").slice(0, 12),
+  cpuThrottle: Number(args["cpu-throttle"]),
+  routes: routeSizes(OUT_DIR),
+  browser: null,
+};
+
+console.log("\n=== export size per route ===");
+console.table(Object.fromEntries(result.routes.map((r) => [r.route, r.metrics])));
+
+if (!args["no-browser"]) {
+  const launched = await launchBrowser();
+  if (launched.skipped) {
+    console.log(`\nBrowser metrics skipped: ${launched.skipped}.`);
+  } else {
+    const server = await serveStatic(OUT_DIR);
+    try {
+      result.browser = await browserMetrics(
+        launched.browser,
+        server.url,
+        decodeCompactProblems(JSON.parse(corpusText)),
+        {
+          runs: Number(args.runs),
+          switches: 10,
+          keystrokes: 30,
+          typedBytes: 16 * 1024,
+          cpuThrottle: result.cpuThrottle,
+        }
+      );
+    } finally {
+      await launched.browser.close();
+      await server.close();
+    }
+    console.log("\n=== /training/ in headless Chrome (medians) ===");
+    console.table(result.browser);
+  }
+}
+
+const base = loadHistory(HISTORY)
+  .filter((r) => r.corpus === result.corpus && r.cpuThrottle === result.cpuThrottle)
+  .at(-1);
+if (base) {
+  console.log(`\n=== compared with ${base.commit ?? "?"} (${base.at}) ===`);
+  console.table(compareResults(base, result));
+} else {
+  console.log("\nNo earlier result for this corpus: nothing to compare with.");
+}
+
+if (!args["no-save"]) {
+  appendHistory(HISTORY, result);
+  console.log(`Saved to ${path.relative(WEB_DIR, HISTORY)}.`);
+}
@@ -0,0 +1,223 @@
+// Browser metrics of the exported `/training` page in headless Chrome, through `puppeteer-core`
+// (optional: not a dependency of the app). Timings come from the User Timing marks of
+// `src/lib/perf.ts`, read in the page.
+import { existsSync } from "node:fs";
+
+import { PERF_MARKS } from "@/lib/perf";
+
+import { round } from "../harness.mjs";
+
+/** Must match `STORAGE_KEY` in `src/lib/training/storage.ts`. */
+const STORAGE_KEY = "gtocpp.training.store.v2";
+const SESSION_ID = "ts_bench";
+
+const CHROME_CANDIDATES = [
+  process.env.CHROME_PATH,
+  "/usr/bin/google-chrome",
+  "/usr/bin/google-chrome-stable",
+  "/usr/bin/chromium",
+  "/usr/bin/chromium-browser",
+  "/Applications/Google Chrome.app/Contents/MacOS/Google Chrome",
+];
+
+/** Resolves to a launched browser, or to `{ skipped }` explaining why it cannot run. */
+export async function launchBrowser() {
+  let puppeteer;
+  try {
+    puppeteer = (await import("puppeteer-core")).default;
+  } catch {
+    return { skipped: "puppeteer-core is not installed (npm install --no-save puppeteer-core)" };
+  }
+
+  const executablePath = CHROME_CANDIDATES.find((p) => p && existsSync(p));
+  if (!executablePath) return { skipped: "no Chrome/Chromium found (set CHROME_PATH)" };
+
+  return { browser: await puppeteer.launch({ executablePath, headless: true }) };
+}
+
+/** A store with one active session over `problemIds` (layout of `src/lib/training/model.ts`). */
+function sessionStore(problemIds, config) {
+  const t = Date.now();
+  const session = {
+    meta: { id: SESSION_ID, title: "Benchmark", createdAt: t, lastOpenedAt: t, status: "active" },
+    config: {
+      difficultyMin: 1,
+      difficultyMax: 5,
+      maxAttemptsPerProblem: null,
+      concepts: [],
+      problemsPerSession: problemIds.length,
+      problemTimer: null,
+      sessionTimer: null,
+      problemOrder: "random",
+      showOutputDifference: true,
+      seed: 0,
+      ...config,
+    },
+    problemIds,
+    progress: {
+      currentIndex: 0,
+      attemptsOnCurrent: 0,
+      score: { solved: 0, failed: 0, attemptsTotal: 0, correctOnFirstTry: 0 },
+      timers: {
+        sessionSecondsRemaining: null,
+        problemSecondsRemaining: null,
+        sessionStartedAt: t,
+        problemStartedAt: t,
+        lastTickAt: t,
+      },
+      startedAt: t,
+      updatedAt: t,
+    },
+    rev: 1,
+  };
+  return { version: 2, activeSessionId: SESSION_ID, sessionsById: { [SESSION_ID]: session } };
+}
+
+/** Fresh profile (no cache, no service worker) with the session in localStorage. */
+async function openTraining(browser, baseUrl, store, cpuThrottle) {
+  const context = await browser.createBrowserContext();
+  const page = await context.newPage();
+  await page.setViewport({ width: 1280, height: 900 });
+  if (cpuThrottle > 1) await page.emulateCPUThrottling(cpuThrottle);
+
+  await page.evaluateOnNewDocument(
+    (key, value) => window.localStorage.setItem(key, value),
+    STORAGE_KEY,
+    JSON.stringify(store)
+  );
+  await page.goto(`${baseUrl}/training/`, { waitUntil: "load" });
+  await page.waitForFunction(
+    (mark) => performance.getEntriesByName(mark).length > 0,
+    {},
+    PERF_MARKS.answerReady
+  );
+  return { page, close: () => context.close() };
+}
+
+function clickButton(page, label) {
+  return page.evaluate((text) => {
+    const button = Array.from(document.querySelectorAll("button")).find((b) =>
+      b.textContent.trim().startsWith(text)
+    );
+    if (!button) throw new Error(`No "${text}" button`);
+    button.click();
+  }, label);
+}
+
+async function loadMetrics(page) {
+  return page.evaluate((marks) => {
+    const at = (name) => performance.getEntriesByName(name)[0]?.startTime ?? null;
+    const fcp = performance.getEntriesByName("first-contentful-paint")[0]?.startTime ?? null;
+    return {
+      fcpMs: fcp,
+      hydratedMs: at(marks.workspaceHydrated),
+      firstInteractiveMs: at(marks.answerReady),
+    };
+  }, PERF_MARKS);
+}
+
+/** Click "Next problem" and time the commit of the new problem and the following paint. */
+async function switchProblem(page) {
+  await clickButton(page, "Give up");
+  await page.waitForFunction(() =>
+    Array.from(document.querySelectorAll("button")).some((b) =>
+      b.textContent.trim().startsWith("Next problem")
+    )
+  );
+
+  return page.evaluate(
+    (mark) =>
+      new Promise((resolve) => {
+        const next = Array.from(document.querySelectorAll("button")).find((b) =>
+          b.textContent.trim().startsWith("Next problem")
+        );
+        const t0 = performance.now();
+        next.click();
+        requestAnimationFrame(() =>
+          setTimeout(() => {
+            const paint = performance.now();
+            const rendered = performance.getEntriesByName(mark).find((m) => m.startTime >= t0);
+            resolve({ renderMs: rendered ? rendered.startTime - t0 : null, paintMs: paint - t0 });
+          })
+        );
+      }),
+    PERF_MARKS.problemRendered
+  );
+}
+
+/** Type into the answer box already holding `text`; keydown → next paint, per keystroke. */
+async function keystrokeLatencies(page, text, keystrokes) {
+  await page.evaluate((value) => {
+    const textarea = document.querySelector("textarea");
+    const setValue = Object.getOwnPropertyDescriptor(HTMLTextAreaElement.prototype, "value").set;
+    setValue.call(textarea, value);
+    textarea.dispatchEvent(new Event("input", { bubbles: true }));
+    textarea.focus();
+    textarea.setSelectionRange(value.length, value.length);
+
+    window.__keyLatencies = [];
+    textarea.addEventListener("keydown", (e) => {
+      const t0 = e.timeStamp;
+      requestAnimationFrame(() =>
+        setTimeout(() => window.__keyLatencies.push(performance.now() - t0))
+      );
+    });
+  }, text);
+
+  await page.keyboard.type("x".repeat(keystrokes), { delay: 50 });
+  await page.waitForFunction((n) => window.__keyLatencies.length >= n, {}, keystrokes);
+  return page.evaluate(() => window.__keyLatencies);
+}
+
+function median(values) {
+  const sorted = values.filter((v) => v !== null).sort((a, b) => a - b);
+  return sorted.length ? sorted[Math.floor(sorted.length / 2)] : null;
+}
+
+function percentile(values, q) {
+  const sorted = values.slice().sort((a, b) => a - b);
+  return sorted[Math.min(sorted.length - 1, Math.floor(q * sorted.length))];
+}
+
+const roundMs = (v) => (v === null ? null : round(v, 1));
+
+/**
+ * `corpus`: decoded problems. Sessions run through the first problems (switches) and through
+ * the problem with the largest expected stdout (keystrokes), padded to `typedBytes`.
+ */
+export async function browserMetrics(browser, baseUrl, corpus, options) {
+  const { runs, switches, keystrokes, typedBytes, cpuThrottle } = options;
+
+  const switchIds = corpus.slice(0, switches + 1).map((p) => p.id);
+  const largest = corpus
+    .filter((p) => p.result.errorType === "no-error")
+    .reduce((a, b) => ((b.result.stdout ?? "").length > (a.result.stdout ?? "").length ? b : a));
+  const expected = largest.result.stdout ?? "";
+  const typed = expected.repeat(Math.max(1, Math.ceil(typedBytes / Math.max(1, expected.length))));
+
+  const loads = [];
+  const switchTimes = [];
+  const keyTimes = [];
+
+  for (let run = 0; run < runs; run++) {
+    const training = await openTraining(browser, baseUrl, sessionStore(switchIds), cpuThrottle);
+    loads.push(await loadMetrics(training.page));
+    for (let i = 0; i < switches; i++) switchTimes.push(await switchProblem(training.page));
+    await training.close();
+
+    const typing = await openTraining(browser, baseUrl, sessionStore([largest.id]), cpuThrottle);
+    keyTimes.push(...(await keystrokeLatencies(typing.page, typed, keystrokes)));
+    await typing.close();
+  }
+
+  return {
+    fcpMs: roundMs(median(loads.map((l) => l.fcpMs))),
+    hydratedMs: roundMs(median(loads.map((l) => l.hydratedMs))),
+    firstInteractiveMs: roundMs(median(loads.map((l) => l.firstInteractiveMs))),
+    switchRenderMs: roundMs(median(switchTimes.map((s) => s.renderMs))),
+    switchPaintMs: roundMs(median(switchTimes.map((s) => s.paintMs))),
+    keyToPaintMs: roundMs(median(keyTimes)),
+    keyToPaintP95Ms: roundMs(percentile(keyTimes, 0.95)),
+    typedKB: round(typed.length / 1024, 1),
+  };
+}
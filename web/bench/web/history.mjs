@@ -0,0 +1,59 @@
+// Result history (`bench/history/web.json`) and the comparison of two runs.
+import path from "node:path";
+import { mkdirSync, readFileSync, writeFileSync } from "node:fs";
+
+import { round } from "../harness.mjs";
+
+/** Relative change below which a metric is reported as unchanged (timing noise). */
+const NOISE_RATIO = 0.05;
+
+export function loadHistory(file) {
+  try {
+    return JSON.parse(readFileSync(file, "utf8"));
+  } catch {
+    return [];
+  }
+}
+
+export function appendHistory(file, result) {
+  const history = loadHistory(file);
+  history.push(result);
+  mkdirSync(path.dirname(file), { recursive: true });
+  writeFileSync(file, `${JSON.stringify(history, null, 2)}\n`);
+}
+
+/** Every numeric metric of a result as `"<group> <name>"` → value. Lower is better for all. */
+function flatten(result) {
+  const metrics = new Map();
+  for (const { route, metrics: m } of result.routes) {
+    for (const [name, value] of Object.entries(m)) metrics.set(`${route} ${name}`, value);
+  }
+  for (const [name, value] of Object.entries(result.browser ?? {})) {
+    if (typeof value === "number") metrics.set(`/training/ ${name}`, value);
+  }
+  return metrics;
+}
+
+export function compareResults(base, current) {
+  const before = flatten(base);
+  const rows = [];
+
+  for (const [metric, after] of flatten(current)) {
+    const prev = before.get(metric);
+    if (prev === undefined) continue;
+
+    const ratio = prev === 0 ? (after === 0 ? 0 : Infinity) : (after - prev) / prev;
+    let verdict = "=";
+    if (ratio > NOISE_RATIO) verdict = "worse";
+    else if (ratio < -NOISE_RATIO) verdict = "better";
+
+    rows.push({
+      metric,
+      before: prev,
+      after,
+      change: Number.isFinite(ratio) ? `${ratio >= 0 ? "+" : ""}${round(ratio * 100, 1)}%` : "new",
+      verdict,
+    });
+  }
+  return rows;
+}
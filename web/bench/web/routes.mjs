@@ -0,0 +1,52 @@
+// Static export size per route: the HTML and the JavaScript it loads, raw and gzip.
+import path from "node:path";
+import { gzipSync } from "node:zlib";
+import { readFileSync, readdirSync } from "node:fs";
+
+import { round } from "../harness.mjs";
+
+const SCRIPT_SRC = /<script\b[^>]*\bsrc="([^"]+\.js)"/g;
+
+const kb = (n) => round(n / 1024, 1);
+const gzipBytes = (data) => gzipSync(data, { level: 9 }).length;
+
+/** `index.html` → `/`, `training/index.html` → `/training/`. */
+function routeOf(htmlFile) {
+  const route = `/${htmlFile.split(path.sep).join("/")}`;
+  return route.endsWith("/index.html") ? route.slice(0, -"index.html".length) : route;
+}
+
+export function routeSizes(outDir) {
+  const pages = readdirSync(outDir, { recursive: true })
+    .filter((file) => file.endsWith(".html") && !file.startsWith("_next"))
+    .sort();
+
+  const gzipCache = new Map();
+  const scriptSize = (src) => {
+    let size = gzipCache.get(src);
+    if (!size) {
+      const data = readFileSync(path.join(outDir, src.replace(/^\/+/, "")));
+      size = { raw: data.length, gzip: gzipBytes(data) };
+      gzipCache.set(src, size);
+    }
+    return size;
+  };
+
+  return pages.map((file) => {
+    const html = readFileSync(path.join(outDir, file));
+    const sources = Array.from(html.toString().matchAll(SCRIPT_SRC), (m) => m[1]);
+    const scripts = Array.from(new Set(sources));
+    const js = scripts.map(scriptSize);
+
+    return {
+      route: routeOf(file),
+      metrics: {
+        htmlKB: kb(html.length),
+        htmlGzipKB: kb(gzipBytes(html)),
+        jsFiles: scripts.length,
+        jsKB: kb(js.reduce((sum, s) => sum + s.raw, 0)),
+        jsGzipKB: kb(js.reduce((sum, s) => sum + s.gzip, 0)),
+      },
+    };
+  });
+}
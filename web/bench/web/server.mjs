@@ -0,0 +1,57 @@
+// Static file server for `out/` on localhost, close to how the export is hosted (no compression).
+import path from "node:path";
+import { createServer } from "node:http";
+import { readFile } from "node:fs/promises";
+
+const CONTENT_TYPES = {
+  ".html": "text/html; charset=utf-8",
+  ".js": "text/javascript; charset=utf-8",
+  ".css": "text/css; charset=utf-8",
+  ".json": "application/json; charset=utf-8",
+  ".txt": "text/plain; charset=utf-8",
+  ".svg": "image/svg+xml",
+  ".ico": "image/x-icon",
+  ".png": "image/png",
+  ".woff2": "font/woff2",
+};
+
+async function readExported(outDir, pathname) {
+  const relative = decodeURIComponent(pathname).replace(/^\/+/, "");
+  const candidates =
+    relative === "" || relative.endsWith("/")
+      ? [`${relative}index.html`]
+      : [relative, `${relative}/index.html`, `${relative}.html`];
+
+  for (const candidate of candidates) {
+    const file = path.resolve(outDir, candidate);
+    if (!file.startsWith(outDir + path.sep)) return null;
+    const data = await readFile(file).catch(() => null);
+    if (data) return { file, data };
+  }
+  return null;
+}
+
+/** Serve `outDir` on a free port. Resolves to `{ url, close }`. */
+export function serveStatic(outDir) {
+  const root = path.resolve(outDir);
+  const server = createServer(async (req, res) => {
+    const { pathname } = new URL(req.url ?? "/", "http://localhost");
+    const found = await readExported(root, pathname);
+    if (!found) {
+      res.writeHead(404).end();
+      return;
+    }
+    const type = CONTENT_TYPES[path.extname(found.file)] ?? "application/octet-stream";
+    res.writeHead(200, { "Content-Type": type, "Cache-Control": "no-cache" }).end(found.data);
+  });
+
+  return new Promise((resolve) => {
+    server.listen(0, "127.0.0.1", () => {
+      const { port } = server.address();
+      resolve({
+        url: `http://127.0.0.1:${port}`,
+        close: () => new Promise((done) => server.close(done)),
+      });
+    });
+  });
+}
@@ -0,0 +1,171 @@
+/**
+ * Offline-first service worker for the static export.
+ *
+ * `sw-manifest.json` (written after `next build` by `scripts/sw-manifest.mjs`) lists every
+ * exported file with a content hash. Files are cached under `<path>?sw-hash=<hash>`, so a new
+ * deployment only invalidates the files whose content changed.
+ *
+ * - install: precache the entries flagged `precache` (app shell, home page and its problem index)
+ * - fetch: cache-first for every file of the manifest, other files are cached on first use
+ * - the manifest itself is stale-while-revalidate: served from cache, refreshed on navigations
+ */
+
+const MANIFEST_PATH = "sw-manifest.json";
+const FILES_CACHE = "gtocpp-files-v1";
+const META_CACHE = "gtocpp-meta-v1";
+const MANIFEST_REVALIDATE_MS = 60 * 1000;
+
+let manifestPromise = null;
+let lastRevalidationAt = 0;
+
+function scopeUrl(path) {
+  return new URL(path, self.registration.scope).href;
+}
+
+function indexManifest(json) {
+  return {
+    version: json.version,
+    byPath: new Map(json.files.map((entry) => [entry.path, entry])),
+  };
+}
+
+function cacheKey(entry) {
+  return `${scopeUrl(entry.path)}?sw-hash=${entry.hash}`;
+}
+
+async function fetchManifest() {
+  const response = await fetch(scopeUrl(MANIFEST_PATH), { cache: "no-cache" });
+  if (!response.ok) throw new Error(`Cannot fetch ${MANIFEST_PATH}: ${response.status}`);
+
+  const cache = await caches.open(META_CACHE);
+  await cache.put(scopeUrl(MANIFEST_PATH), response.clone());
+  return indexManifest(await response.json());
+}
+
+async function loadManifest() {
+  const cache = await caches.open(META_CACHE);
+  const cached = await cache.match(scopeUrl(MANIFEST_PATH));
+  if (cached) return indexManifest(await cached.json());
+  return fetchManifest();
+}
+
+function getManifest() {
+  if (!manifestPromise) {
+    manifestPromise = loadManifest().catch((error) => {
+      manifestPromise = null;
+      throw error;
+    });
+  }
+  return manifestPromise;
+}
+
+async function fetchIntoCache(cache, entry) {
+  const response = await fetch(scopeUrl(entry.path), { cache: "no-cache" });
+  if (response.ok) await cache.put(cacheKey(entry), response.clone());
+  return response;
+}
+
+async function precache(manifest) {
+  const cache = await caches.open(FILES_CACHE);
+  const missing = [];
+  for (const entry of manifest.byPath.values()) {
+    if (entry.precache && !(await cache.match(cacheKey(entry)))) missing.push(entry);
+  }
+  await Promise.all(missing.map((entry) => fetchIntoCache(cache, entry)));
+}
+
+/** Drop cached files that are not part of `manifest` (changed or removed). */
+async function prune(manifest) {
+  const valid = new Set(Array.from(manifest.byPath.values(), cacheKey));
+  const cache = await caches.open(FILES_CACHE);
+  const keys = await cache.keys();
+  await Promise.all(keys.filter((req) => !valid.has(req.url)).map((req) => cache.delete(req)));
+}
+
+async function revalidateManifest() {
+  const t = Date.now();
+  if (t - lastRevalidationAt < MANIFEST_REVALIDATE_MS) return;
+  lastRevalidationAt = t;
+
+  const current = await getManifest();
+  const next = await fetchManifest();
+  if (next.version === current.version) return;
+
+  manifestPromise = Promise.resolve(next);
+  await prune(next);
+  await precache(next);
+}
+
+/** Manifest entry for a request path (`training/` is served by `training/index.html`). */
+function findEntry(manifest, url) {
+  const scopePath = new URL(self.registration.scope).pathname;
+  if (!url.pathname.startsWith(scopePath)) return null;
+
+  const path = decodeURIComponent(url.pathname.slice(scopePath.length));
+  const candidates =
+    path === "" || path.endsWith("/")
+      ? [`${path}index.html`]
+      : [path, `${path}/index.html`, `${path}.html`];
+
+  for (const candidate of candidates) {
+    const entry = manifest.byPath.get(candidate);
+    if (entry) return entry;
+  }
+  return null;
+}
+
+async function respond(request) {
+  const url = new URL(request.url);
+
+  let manifest;
+  try {
+    manifest = await getManifest();
+  } catch {
+    return fetch(request);
+  }
+
+  const entry = findEntry(manifest, url);
+  if (!entry || entry.path === MANIFEST_PATH) return fetch(request);
+
+  const cache = await caches.open(FILES_CACHE);
+  const cached = await cache.match(cacheKey(entry));
+  if (cached) return cached;
+
+  return fetchIntoCache(cache, entry);
+}
+
+self.addEventListener("install", (event) => {
+  event.waitUntil(
+    fetchManifest()
+      .then((manifest) => {
+        manifestPromise = Promise.resolve(manifest);
+        return precache(manifest);
+      })
+      .then(() => self.skipWaiting())
+  );
+});
+
+self.addEventListener("activate", (event) => {
+  event.waitUntil(
+    (async () => {
+      const names = await caches.keys();
+      const current = new Set([FILES_CACHE, META_CACHE]);
+      const stale = names.filter((name) => name.startsWith("gtocpp-") && !current.has(name));
+      await Promise.all(stale.map((name) => caches.delete(name)));
+      await prune(await getManifest());
+      await self.clients.claim();
+    })()
+  );
+});
+
+self.addEventListener("fetch", (event) => {
+  const { request } = event;
+  if (request.method !== "GET" || new URL(request.url).origin !== self.location.origin) return;
+
+  event.respondWith(respond(request));
+
+  if (request.mode === "navigate") {
+    // Stale-while-revalidate: the page is served from cache, the manifest refreshed behind it.
+    event.waitUntil(revalidateManifest().catch(() => {}));
+  }
+});
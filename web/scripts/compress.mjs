@@ -0,0 +1,43 @@
+// Post-build step: precompressed .br/.gz siblings for the text assets of the static export, for
+// hosts that serve them as-is (e.g. `Content-Encoding` negotiation in nginx/Caddy/serve).
+import path from "node:path";
+import { promisify } from "node:util";
+import { brotliCompress, constants, gzip } from "node:zlib";
+import { readFile, readdir, writeFile } from "node:fs/promises";
+
+const OUT_DIR = path.resolve(import.meta.dirname, "..", "out");
+const COMPRESSIBLE = /\.(html|txt|js|css|json|svg|map)$/;
+const MIN_BYTES = 1024;
+
+const brotli = promisify(brotliCompress);
+const gz = promisify(gzip);
+
+let raw = 0;
+let br = 0;
+let count = 0;
+
+for (const file of await readdir(OUT_DIR, { recursive: true })) {
+  if (!COMPRESSIBLE.test(file)) continue;
+
+  const full = path.join(OUT_DIR, file);
+  const data = await readFile(full).catch(() => null); // directories matching the pattern
+  if (!data || data.length < MIN_BYTES) continue;
+
+  const [brData, gzData] = await Promise.all([
+    brotli(data, {
+      params: {
+        [constants.BROTLI_PARAM_QUALITY]: constants.BROTLI_MAX_QUALITY,
+        [constants.BROTLI_PARAM_SIZE_HINT]: data.length,
+      },
+    }),
+    gz(data, { level: 9 }),
+  ]);
+  await Promise.all([writeFile(full + ".br", brData), writeFile(full + ".gz", gzData)]);
+
+  raw += data.length;
+  br += brData.length;
+  count++;
+}
+
+const kb = (n) => `${(n / 1024).toFixed(1)} KB`;
+console.log(`✔ Precompressed ${count} files: ${kb(raw)} → ${kb(br)} (br)`);
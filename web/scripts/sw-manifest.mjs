@@ -0,0 +1,64 @@
+// Post-build step: content-hash every file of the static export into `out/sw-manifest.json`,
+// which drives the service worker caches (see `public/sw.js`).
+import path from "node:path";
+import { createHash } from "node:crypto";
+import { readFile, readdir, writeFile } from "node:fs/promises";
+
+const OUT_DIR = path.resolve(import.meta.dirname, "..", "out");
+const MANIFEST = "sw-manifest.json";
+
+/** Never served through the cache (the worker itself, its manifest, precompressed siblings). */
+const EXCLUDED = new Set(["sw.js", MANIFEST]);
+const PRECOMPRESSED = /\.(br|gz)$/;
+
+/**
+ * Precached at install: the app shell (HTML pages, build assets, fonts, icons) and the home page
+ * payload, which carries the problem index. The other route payloads (client-side navigation
+ * data, including the problems) are cached on first use.
+ */
+function isPrecached(file) {
+  if (file.startsWith("_next/static/")) return true;
+  if (file.endsWith(".html") || file.endsWith(".ico")) return true;
+  return !file.includes("/") && file.endsWith(".txt");
+}
+
+async function listFiles(dir, prefix = "") {
+  const files = [];
+  for (const entry of await readdir(dir, { withFileTypes: true })) {
+    const rel = prefix + entry.name;
+    if (entry.isDirectory()) {
+      files.push(...(await listFiles(path.join(dir, entry.name), rel + "/")));
+    } else if (entry.isFile()) {
+      files.push(rel);
+    }
+  }
+  return files;
+}
+
+function hash(data) {
+  return createHash("sha256").update(data).digest("hex").slice(0, 16);
+}
+
+const files = (await listFiles(OUT_DIR))
+  .filter((f) => !EXCLUDED.has(f) && !PRECOMPRESSED.test(f))
+  .sort();
+
+const entries = [];
+let totalBytes = 0;
+let precacheBytes = 0;
+for (const file of files) {
+  const data = await readFile(path.join(OUT_DIR, file));
+  const precache = isPrecached(file);
+  totalBytes += data.length;
+  if (precache) precacheBytes += data.length;
+  entries.push({ path: file, hash: hash(data), size: data.length, precache });
+}
+
+const version = hash(entries.map((e) => `${e.path}:${e.hash}`).join("\n"));
+await writeFile(path.join(OUT_DIR, MANIFEST), JSON.stringify({ version, files: entries }));
+
+const kb = (n) => `${(n / 1024).toFixed(1)} KB`;
+console.log(
+  `✔ ${MANIFEST} ${version}: ${entries.length} files (${kb(totalBytes)}), ` +
+    `precached ${entries.filter((e) => e.precache).length} (${kb(precacheBytes)})`
+);
@@ -6,6 +6,7 @@ import { ThemeProvider } from "next-themes";
 import { cn } from "@/lib/utils";
 
 import Header from "@/components/layout/header/Header";
+import ServiceWorker from "@/components/layout/ServiceWorker";
 
 import "@/styles/globals.css";
 
@@ -27,6 +28,7 @@ export default function RootLayout({ children }: { children: React.ReactNode })
         className="h-full w-full font-sans antialiased"
         suppressHydrationWarning
       >
+        <ServiceWorker />
         <ThemeProvider attribute="class">
           <div
             className={cn(
@@ -1,8 +1,9 @@
-import problemIndex from "#data/problems.index.json";
+import facets from "#data/problems.facets.json";
 
 import { cn } from "@/lib/utils";
+import type { FacetIndexData } from "@/lib/facets";
 
-import HomeSection, { ProblemIndexEntry } from "@/components/sections/home/HomeSection";
+import HomeSection from "@/components/sections/home/HomeSection";
 
 export default function Home() {
   return (
@@ -11,7 +12,7 @@ export default function Home() {
         "flex min-h-[calc(100vh-48px)] flex-col items-center justify-center overflow-x-clip px-4"
       )}
     >
-      <HomeSection problemIndex={problemIndex as ProblemIndexEntry[]} />
+      <HomeSection facets={facets as FacetIndexData} />
     </div>
   );
 }
@@ -1,29 +1,33 @@
-import problems from "#data/problems.generated.json";
+import compactProblems from "#data/problems.compact.json";
 
-import { ProblemData } from "@/lib/problems";
+import { CompactProblemsData, decodeCompactProblems, withoutRenderedFields } from "@/lib/problems";
 
 import CodeHighlight from "@/components/sections/problem/CodeHighlight";
-import ProblemWorkspace, { ProblemsById } from "@/components/sections/problem/ProblemWorkspace";
+import { ExplanationMarkdown } from "@/components/sections/problem/ExplanationMarkdown";
+import ProblemWorkspace, { RenderedBlocks } from "@/components/sections/problem/ProblemWorkspace";
 
-function generateProblemsById(problems: ProblemData[]): ProblemsById {
-  const map: ProblemsById = {};
-  for (const problem of problems) {
-    map[problem.id] = {
-      ...problem,
-      codeBlock: <CodeHighlight code={problem.code} />,
+const data = compactProblems as unknown as CompactProblemsData;
+
+function renderBlocks(): Record<string, RenderedBlocks> {
+  const blocks: Record<string, RenderedBlocks> = {};
+  for (const { id, code, explanation } of decodeCompactProblems(data)) {
+    blocks[id] = {
+      codeBlock: <CodeHighlight code={code} />,
+      explanationBlock: <ExplanationMarkdown markdown={explanation} />,
     };
   }
-  return map;
+  return blocks;
 }
 
 export default function TrainingPage() {
-  const problemsById = generateProblemsById(problems as ProblemData[]);
-
   return (
     <main
       className="flex min-h-[calc(100vh-48px)] flex-col items-center justify-start overflow-x-clip"
     >
-      <ProblemWorkspace problemsById={problemsById} />
+      <ProblemWorkspace
+        problems={withoutRenderedFields(data)}
+        blocksById={renderBlocks()}
+      />
     </main>
   );
 }
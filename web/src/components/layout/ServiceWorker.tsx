@@ -0,0 +1,21 @@
+"use client";
+
+import { useEffect } from "react";
+
+/**
+ * Registers `public/sw.js` (offline cache of the static export).
+ * Production only: the dev server has no `sw-manifest.json`.
+ */
+const ServiceWorker = () => {
+  useEffect(() => {
+    if (process.env.NODE_ENV !== "production" || !("serviceWorker" in navigator)) return;
+
+    navigator.serviceWorker.register("/sw.js").catch((error) => {
+      console.warn("Service worker registration failed:", error);
+    });
+  }, []);
+
+  return null;
+};
+
+export default ServiceWorker;
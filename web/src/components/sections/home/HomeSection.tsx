@@ -4,72 +4,74 @@ import * as React from "react";
 
 import { useRouter } from "next/navigation";
 
-import { cn, intersects } from "@/lib/utils";
-import { createTrainingSession } from "@/lib/training";
-import type { ProblemDifficulty } from "@/lib/problems";
+import { cn } from "@/lib/utils";
+import {
+  createRng,
+  createTrainingSession,
+  randomSeed,
+  sampleWithoutReplacement,
+  stratifiedSample,
+} from "@/lib/training";
 import { type TrainingConfig, defaultTrainingConfig } from "@/lib/training/config";
-
+import {
+  type FacetFilter,
+  type FacetIndex,
+  type FacetIndexData,
+  bitsToPositions,
+  countBits,
+  decodeFacetIndex,
+  matchFacets,
+} from "@/lib/facets";
+
+import { ProblemSearchPanel } from "./ProblemSearchPanel";
 import { TrainingPresetPanel } from "./TrainingPresetPanel";
 import { TrainingSessionsPanel } from "./TrainingSessionsPanel";
 
-export type ProblemIndexEntry = {
-  id: string;
-  difficulty: ProblemDifficulty;
-  concepts: string[];
-};
-
 interface HomeSectionProps {
   /**
-   * Build-time data: small index of problems used to create subsets fast.
+   * Build-time data: concept/difficulty facets of every problem, used to filter fast.
    * Provided by importing a generated JSON.
    */
-  problemIndex: ProblemIndexEntry[];
+  facets: FacetIndexData;
 }
 
-function buildSubsetIds(index: ProblemIndexEntry[], config: TrainingConfig): string[] {
-  const filtered = index.filter((p) => {
-    const diffOk = p.difficulty >= config.difficultyMin && p.difficulty <= config.difficultyMax;
-    const conceptOk = intersects(config.concepts ?? [], p.concepts ?? []);
-    return diffOk && conceptOk;
-  });
-
-  // eslint-disable-next-line sonarjs/pseudo-random
-  filtered.sort(() => Math.random() - 0.5);
-
-  // Limit size
-  const limit = config.problemsPerSession ?? null;
-  let sliced = filtered;
-  if (limit != null) sliced = filtered.slice(0, Math.max(0, limit));
-
-  if (config.problemOrder === "random") {
-    // eslint-disable-next-line sonarjs/pseudo-random
-    sliced.sort(() => Math.random() - 0.5);
-  } else if (config.problemOrder === "progressive") {
-    sliced.sort((a, b) => a.difficulty - b.difficulty);
-  }
-
-  return sliced.map((p) => p.id);
+/**
+ * Draw the session's problems with a seeded RNG (see `lib/training/sampling`).
+ * - random: uniform sample, already in random order
+ * - progressive: sample stratified by difficulty, easiest stratum first
+ */
+function buildSubsetIds(index: FacetIndex, config: TrainingConfig, seed: number): string[] {
+  const positions = bitsToPositions(matchFacets(index, config));
+  const limit = config.problemsPerSession ?? positions.length; // null = endless: take them all
+  const rng = createRng(seed);
+
+  const picked =
+    config.problemOrder === "progressive"
+      ? stratifiedSample(positions, limit, (pos) => index.difficultyOf[pos as number], rng)
+      : sampleWithoutReplacement(positions, limit, rng);
+
+  return picked.map((pos) => index.problemIds[pos as number]);
 }
 
-export default function HomeSection({ problemIndex }: HomeSectionProps) {
+export default function HomeSection({ facets }: HomeSectionProps) {
   const router = useRouter();
 
-  const concepts = Array.from(
-    new Set(
-      problemIndex.reduce((prev, curr) => {
-        return { concepts: [...prev.concepts, ...curr.concepts] } as ProblemIndexEntry;
-      }).concepts
-    )
+  const index = React.useMemo(() => decodeFacetIndex(facets), [facets]);
+
+  const countMatches = React.useCallback(
+    (filter: FacetFilter) => countBits(matchFacets(index, filter)),
+    [index]
   );
 
   const startNewSession = React.useCallback(
     (config: TrainingConfig) => {
-      const subsetIds = buildSubsetIds(problemIndex, config);
+      const seed = config.seed ?? randomSeed();
+      const subsetIds = buildSubsetIds(index, config, seed);
 
       if (subsetIds.length === 0) return;
 
       createTrainingSession({
-        config,
+        config: { ...config, seed },
         problemIds: subsetIds,
         activate: true,
         title: "Training session",
@@ -77,7 +79,23 @@ export default function HomeSection({ problemIndex }: HomeSectionProps) {
 
       router.push(`/training`);
     },
-    [problemIndex, router]
+    [index, router]
+  );
+
+  const startSearchSession = React.useCallback(
+    (problemIds: string[], query: string) => {
+      if (problemIds.length === 0) return;
+
+      createTrainingSession({
+        config: { ...defaultTrainingConfig, problemsPerSession: problemIds.length },
+        problemIds,
+        activate: true,
+        title: `Search: ${query}`,
+      });
+
+      router.push(`/training`);
+    },
+    [router]
   );
 
   return (
@@ -103,10 +121,13 @@ export default function HomeSection({ problemIndex }: HomeSectionProps) {
       <div className="w-full max-w-3xl space-y-6">
         <TrainingPresetPanel
           defaultConfig={defaultTrainingConfig}
-          availableConcepts={concepts}
+          availableConcepts={index.concepts}
+          countMatches={countMatches}
           onStart={startNewSession}
         />
 
+        <ProblemSearchPanel onStart={startSearchSession} />
+
         <TrainingSessionsPanel />
       </div>
     </section>
@@ -0,0 +1,101 @@
+"use client";
+
+import * as React from "react";
+
+import { Gauge, Play, Search } from "lucide-react";
+
+import { cn } from "@/lib/utils";
+import { preloadSearch } from "@/lib/search";
+
+import { useProblemSearch } from "@/hooks/useProblemSearch";
+
+import { Button, Input } from "@/components/ui/inputs";
+import { Badge } from "@/components/ui/data_display";
+import { Card, CardContent, CardHeader, CardTitle } from "@/components/ui/surfaces";
+
+/** Results listed under the search box; a session can still use every match. */
+const VISIBLE_HITS = 8;
+
+type ProblemSearchPanelProps = {
+  className?: string;
+  /** Start a session on the matching problems (best match first). */
+  onStart?: (problemIds: string[], query: string) => void;
+};
+
+export function ProblemSearchPanel({ className, onStart }: ProblemSearchPanelProps) {
+  const [query, setQuery] = React.useState("");
+  const { result, error, pending } = useProblemSearch(query);
+
+  const hits = result?.hits.slice(0, VISIBLE_HITS) ?? [];
+  const total = result?.ids.length ?? 0;
+  const hasQuery = query.trim() !== "";
+
+  return (
+    <Card className={cn("w-full", className)}>
+      <CardHeader className="space-y-2">
+        <CardTitle className="text-xl">Find problems</CardTitle>
+        <div className="relative">
+          <Search className="text-muted-foreground absolute top-2.5 left-3 h-4 w-4" />
+          <Input
+            type="search"
+            className="pl-9"
+            placeholder="Search titles, explanations, concepts and code (e.g. virtual dtor)"
+            value={query}
+            onFocus={preloadSearch}
+            onChange={(e) => setQuery(e.target.value)}
+            aria-label="Search problems"
+          />
+        </div>
+      </CardHeader>
+
+      {hasQuery && (
+        <CardContent className="space-y-3">
+          {error ? (
+            <p className="text-sm text-red-500">Search is unavailable: {error}</p>
+          ) : (
+            <div className="text-muted-foreground flex items-center justify-between gap-3 text-xs">
+              <span>
+                {result ? `${total} ${total === 1 ? "match" : "matches"}` : "Searching…"}
+                {result && pending ? " (updating…)" : null}
+              </span>
+              {result && <span>{result.tookMs.toFixed(1)} ms</span>}
+            </div>
+          )}
+
+          {hits.length > 0 && (
+            <ul className="divide-border divide-y rounded-md border">
+              {hits.map((hit) => (
+                <li
+                  key={hit.id}
+                  className="flex items-center justify-between gap-3 px-3 py-2"
+                >
+                  <span className="text-foreground min-w-0 truncate text-sm">{hit.title}</span>
+                  <Badge
+                    variant="outline"
+                    title="Difficulty"
+                  >
+                    <Gauge />
+                    {hit.difficulty}
+                  </Badge>
+                </li>
+              ))}
+            </ul>
+          )}
+
+          {total > 0 && (
+            <div className="flex justify-end">
+              <Button
+                type="button"
+                onClick={() => result && onStart?.(result.ids, result.query)}
+                disabled={!onStart}
+              >
+                <Play className="h-4 w-4" />
+                Train on {total === 1 ? "this problem" : `these ${total} problems`}
+              </Button>
+            </div>
+          )}
+        </CardContent>
+      )}
+    </Card>
+  );
+}
@@ -5,6 +5,8 @@ import { useState } from "react";
 import { InfinityIcon } from "lucide-react";
 
 import { cn } from "@/lib/utils";
+import type { FacetFilter } from "@/lib/facets";
+import { parseSeed } from "@/lib/training/sampling";
 import {
   PROBLEM_MAX_DIFFICULTY,
   PROBLEM_MIN_DIFFICULTY,
@@ -39,6 +41,7 @@ import {
 } from "@/components/ui/surfaces";
 import {
   Button,
+  Input,
   MultiSelectCombobox,
   NumericStepper,
   RadioGroup,
@@ -50,12 +53,15 @@ import {
 type TrainingPresetPanelProps = {
   availableConcepts?: string[];
   defaultConfig?: Partial<TrainingConfig>;
+  /** Number of problems matching the current filters (live feedback, optional). */
+  countMatches?: (filter: FacetFilter) => number;
   onStart?: (config: TrainingConfig) => void;
 };
 
 export function TrainingPresetPanel({
   availableConcepts = [],
   defaultConfig,
+  countMatches,
   onStart,
 }: TrainingPresetPanelProps) {
   // Core
@@ -88,10 +94,19 @@ export function TrainingPresetPanel({
     defaultConfig?.problemOrder ?? "random"
   );
   const [showDiff, setShowDiff] = useState<boolean>(defaultConfig?.showOutputDifference ?? true);
+  const [seedInput, setSeedInput] = useState<string>(
+    defaultConfig?.seed != null ? String(defaultConfig.seed) : ""
+  );
 
   const difficultyMin = clampDifficulty(Math.min(difficultyRange[0], difficultyRange[1]));
   const difficultyMax = clampDifficulty(Math.max(difficultyRange[0], difficultyRange[1]));
 
+  const matchCount = countMatches?.({ difficultyMin, difficultyMax, concepts }) ?? null;
+
+  // Empty = random seed.
+  const seed = seedInput.trim() === "" ? null : parseSeed(seedInput);
+  const seedInvalid = seedInput.trim() !== "" && seed === null;
+
   const applyDifficultyPreset = (preset: Partial<TrainingConfig>) => {
     const hasMin = preset.difficultyMin !== undefined;
     const hasMax = preset.difficultyMax !== undefined;
@@ -136,6 +151,7 @@ export function TrainingPresetPanel({
   const applyMiscPreset = (preset: Partial<TrainingConfig>) => {
     if (preset.problemOrder !== undefined) setProblemOrder(preset.problemOrder);
     if (preset.showOutputDifference !== undefined) setShowDiff(preset.showOutputDifference);
+    if (preset.seed !== undefined) setSeedInput(preset.seed == null ? "" : String(preset.seed));
   };
 
   const applyPreset = (preset: Partial<TrainingConfig>) => {
@@ -157,6 +173,7 @@ export function TrainingPresetPanel({
     sessionTimer,
     problemOrder,
     showOutputDifference: showDiff,
+    seed,
   });
 
   const start = () => {
@@ -421,6 +438,24 @@ export function TrainingPresetPanel({
                     Highlights incorrect characters (red/green) when your output is close.
                   </p>
                 </div>
+
+                {/* Seed */}
+                <div className="space-y-2">
+                  <Label htmlFor="session-seed">Seed</Label>
+                  <Input
+                    id="session-seed"
+                    inputMode="numeric"
+                    placeholder="Random"
+                    value={seedInput}
+                    onChange={(e) => setSeedInput(e.target.value)}
+                    aria-invalid={seedInvalid}
+                  />
+                  <p className="text-muted-foreground text-xs">
+                    {seedInvalid
+                      ? "Use a whole number between 0 and 4294967295."
+                      : "Same seed and filters give the same problems: replay or share a session."}
+                  </p>
+                </div>
               </div>
             </AccordionContent>
           </AccordionItem>
@@ -435,11 +470,19 @@ export function TrainingPresetPanel({
               Difficulty {difficultyMin}-{difficultyMax}
             </Badge>
           </span>
+          {matchCount !== null && (
+            <span className="ml-2">
+              <Badge variant={matchCount === 0 ? "destructive" : "outline"}>
+                {matchCount} {matchCount === 1 ? "problem matches" : "problems match"}
+              </Badge>
+            </span>
+          )}
         </div>
 
         <Button
           type="button"
           onClick={start}
+          disabled={matchCount === 0 || seedInvalid}
           className="w-full sm:w-auto"
         >
           Start training
@@ -19,17 +19,21 @@ import {
 import { cn, formatDateTime } from "@/lib/utils";
 import type { TrainingSession } from "@/lib/training";
 import {
+  archiveCompletedSessions,
+  countArchivedSessions,
   deleteTrainingSession,
-  getActiveTrainingSessionId,
   getConcepts,
   getDifficultyRange,
   getSessionCounts,
-  listTrainingSessions,
+  isHistoryAvailable,
+  listArchivedSessions,
   resumeTrainingSession,
   setActiveTrainingSession,
-  subscribeStore,
+  subscribeHistory,
 } from "@/lib/training";
 
+import { useActiveSessionId, useLocalSessions } from "@/hooks/useTrainingStore";
+
 import { Button } from "@/components/ui/inputs";
 import { Card } from "@/components/ui/surfaces";
 import { Badge } from "@/components/ui/data_display";
@@ -49,6 +53,13 @@ import {
 
 import TimerChip from "../../utils/TimerChip";
 
+/** Archived (finished) sessions are fetched from IndexedDB by pages of this size. */
+const ARCHIVE_PAGE_SIZE = 10;
+
+function byLastOpened(a: TrainingSession, b: TrainingSession) {
+  return b.meta.lastOpenedAt - a.meta.lastOpenedAt;
+}
+
 export function TrainingSessionsPanel({
   className,
   title = "Your sessions",
@@ -58,18 +69,49 @@ export function TrainingSessionsPanel({
 }) {
   const router = useRouter();
 
-  const [sessions, setSessions] = React.useState<TrainingSession[]>([]);
-  const [activeId, setActiveId] = React.useState<string | null>(null);
+  const localSessions = useLocalSessions();
+  const activeId = useActiveSessionId();
+  const [archivedSessions, setArchivedSessions] = React.useState<TrainingSession[]>([]);
+  const [archivedTotal, setArchivedTotal] = React.useState(0);
+  const [archivedLimit, setArchivedLimit] = React.useState(ARCHIVE_PAGE_SIZE);
 
-  const refresh = React.useCallback(() => {
-    setSessions(listTrainingSessions());
-    setActiveId(getActiveTrainingSessionId());
-  }, []);
+  React.useEffect(() => {
+    if (!isHistoryAvailable()) return;
+
+    let cancelled = false;
+    const refreshArchive = () => {
+      Promise.all([listArchivedSessions({ limit: archivedLimit }), countArchivedSessions()])
+        .then(([page, total]) => {
+          if (cancelled) return;
+          setArchivedSessions(page);
+          setArchivedTotal(total);
+        })
+        .catch(() => {
+          // Archive unavailable (e.g. blocked by the browser): only local sessions are shown.
+        });
+    };
+
+    refreshArchive();
+    const unsubscribe = subscribeHistory(refreshArchive);
+    return () => {
+      cancelled = true;
+      unsubscribe();
+    };
+  }, [archivedLimit]);
 
+  // Finished sessions from a previous visit (or from a v1 store) are moved out of localStorage.
   React.useEffect(() => {
-    refresh();
-    return subscribeStore(refresh);
-  }, [refresh]);
+    archiveCompletedSessions().catch(() => {});
+  }, []);
+
+  const sessions = React.useMemo(() => {
+    // A session is briefly in both places while it is being archived.
+    const localIds = new Set(localSessions.map((s) => s.meta.id));
+    const archived = archivedSessions.filter((s) => !localIds.has(s.meta.id));
+    return [...localSessions, ...archived].sort(byLastOpened);
+  }, [localSessions, archivedSessions]);
+
+  const hasMoreArchived = archivedSessions.length < archivedTotal;
 
   const continueSession = React.useCallback(
     (id: string) => {
@@ -83,7 +125,7 @@ export function TrainingSessionsPanel({
 
   const removeSession = React.useCallback((id: string) => {
     deleteTrainingSession(id);
-    // subscribeStore(refresh) will update the list automatically
+    // useLocalSessions() picks the change up from the store
   }, []);
 
   if (sessions.length === 0) return null;
@@ -113,10 +155,60 @@ export function TrainingSessionsPanel({
           const concepts = getConcepts(s);
           const difficulty = getDifficultyRange(s);
 
+          const completed = s.meta.status === "completed";
           const showTimer =
             (s.progress.timers.problemSecondsRemaining !== null ||
               s.progress.timers.sessionSecondsRemaining !== null) &&
-            s.meta.status !== "completed";
+            !completed;
+
+          const summary = (
+            <>
+              <div className="flex flex-wrap items-center gap-2">
+                <div className="flex items-center gap-2">
+                  <span
+                    className={cn(
+                      "h-2 w-2 rounded-full",
+                      isActive ? "bg-emerald-500" : "bg-muted-foreground/40"
+                    )}
+                    aria-hidden="true"
+                  />
+                  <div className="text-foreground truncate text-sm font-semibold">
+                    {s.meta.title}
+                  </div>
+                </div>
+                {showTimer && (
+                  <TimerChip
+                    className="ml-2"
+                    seconds={
+                      s.progress.timers.problemSecondsRemaining ||
+                      s.progress.timers.sessionSecondsRemaining ||
+                      0
+                    }
+                  />
+                )}
+                <ScoreChip
+                  score={solved}
+                  total={solved + failed}
+                  title="Solved / (Solved + Failed)"
+                  className="ml-2"
+                />
+              </div>
+
+              <div className="text-muted-foreground mt-1 flex flex-wrap items-center gap-2 text-xs">
+                {concepts.length > 0 ? (
+                  <>
+                    <span className="truncate">{concepts.slice(0, 3).join(" • ")}</span>
+                    {concepts.length > 3 ? <span>…</span> : null}
+                  </>
+                ) : null}
+                {s.config.seed != null ? (
+                  <span title="Start a session with this seed to replay it">
+                    Seed {s.config.seed}
+                  </span>
+                ) : null}
+              </div>
+            </>
+          );
 
           return (
             <div
@@ -129,57 +221,22 @@ export function TrainingSessionsPanel({
             >
               {/* Row header */}
               <div className="flex items-start justify-between gap-3">
-                <button
-                  type="button"
-                  onClick={() => continueSession(s.meta.id)}
-                  className="min-w-0 text-left"
-                  title="Continue session"
-                >
-                  <div className="flex flex-wrap items-center gap-2">
-                    <div className="flex items-center gap-2">
-                      <span
-                        className={cn(
-                          "h-2 w-2 rounded-full",
-                          isActive ? "bg-emerald-500" : "bg-muted-foreground/40"
-                        )}
-                        aria-hidden="true"
-                      />
-                      <div className="text-foreground truncate text-sm font-semibold">
-                        {s.meta.title}
-                      </div>
-                    </div>
-                    {showTimer && (
-                      <TimerChip
-                        className="ml-2"
-                        seconds={
-                          s.progress.timers.problemSecondsRemaining ||
-                          s.progress.timers.sessionSecondsRemaining ||
-                          0
-                        }
-                      />
-                    )}
-                    <ScoreChip
-                      score={solved}
-                      total={solved + failed}
-                      title="Solved / (Solved + Failed)"
-                      className="ml-2"
-                    />
-                  </div>
-
-                  <div
-                    className="text-muted-foreground mt-1 flex flex-wrap items-center gap-2 text-xs"
+                {completed ? (
+                  // Finished sessions cannot be resumed, and there is no read-only view of them.
+                  <div className="min-w-0">{summary}</div>
+                ) : (
+                  <button
+                    type="button"
+                    onClick={() => continueSession(s.meta.id)}
+                    className="min-w-0 text-left"
+                    title="Continue session"
                   >
-                    {concepts.length > 0 ? (
-                      <>
-                        <span className="truncate">{concepts.slice(0, 3).join(" • ")}</span>
-                        {concepts.length > 3 ? <span>…</span> : null}
-                      </>
-                    ) : null}
-                  </div>
-                </button>
+                    {summary}
+                  </button>
+                )}
 
                 <div className="flex shrink-0 items-center gap-2">
-                  {s.meta.status !== "completed" && (
+                  {!completed && (
                     <Button
                       onClick={() => continueSession(s.meta.id)}
                       variant="outline"
@@ -189,7 +246,7 @@ export function TrainingSessionsPanel({
                       <ArrowRight className="h-4 w-4" />
                     </Button>
                   )}
-                  {s.meta.status === "completed" && (
+                  {completed && (
                     <Badge
                       className="bg-green-50 text-green-700 dark:bg-green-950 dark:text-green-300"
                     >
@@ -301,6 +358,17 @@ export function TrainingSessionsPanel({
           );
         })}
       </div>
+
+      {hasMoreArchived && (
+        <div className="mt-3 flex justify-center">
+          <Button
+            variant="outline"
+            onClick={() => setArchivedLimit((limit) => limit + ARCHIVE_PAGE_SIZE)}
+          >
+            Show older sessions ({archivedTotal - archivedSessions.length} more)
+          </Button>
+        </div>
+      )}
     </Card>
   );
 }
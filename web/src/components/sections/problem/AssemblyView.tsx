@@ -0,0 +1,126 @@
+"use client";
+
+import * as React from "react";
+
+import { cn } from "@/lib/utils";
+import { ASM_LEVELS, type AsmFunction, type AsmListing, loadAsmListing } from "@/lib/asm";
+
+import {
+  Accordion,
+  AccordionContent,
+  AccordionItem,
+  AccordionTrigger,
+} from "@/components/ui/surfaces";
+
+/**
+ * The -O0 and -O2 assembly of the problem, side by side. Collapsed at first: the listing is only
+ * fetched once opened (the accordion mounts its content on open).
+ */
+export function AssemblyView({ name }: { name: string }) {
+  return (
+    <Accordion
+      type="single"
+      collapsible
+      className="w-full"
+    >
+      <AccordionItem
+        value="asm"
+        className="border-b-0"
+      >
+        <AccordionTrigger className="hover:bg-muted px-2 py-2">
+          Show the -O0 and -O2 assembly
+        </AccordionTrigger>
+        <AccordionContent className="pt-2">
+          <_AsmListingLoader name={name} />
+        </AccordionContent>
+      </AccordionItem>
+    </Accordion>
+  );
+}
+
+function _AsmListingLoader({ name }: { name: string }) {
+  const [listing, setListing] = React.useState<AsmListing | null>(null);
+  const [error, setError] = React.useState<string | null>(null);
+  // Source line under the pointer, highlighted at both levels.
+  const [line, setLine] = React.useState<number | null>(null);
+
+  React.useEffect(() => {
+    let cancelled = false;
+    setListing(null);
+    setError(null);
+    loadAsmListing(name).then(
+      (loaded) => !cancelled && setListing(loaded),
+      (e: Error) => !cancelled && setError(e.message)
+    );
+    return () => {
+      cancelled = true;
+    };
+  }, [name]);
+
+  if (error) return <div className="text-sm text-red-600 dark:text-red-400">{error}</div>;
+  if (!listing) return <div className="text-muted-foreground text-sm italic">Loading…</div>;
+
+  return (
+    <div
+      className="grid gap-3 md:grid-cols-2"
+      onMouseLeave={() => setLine(null)}
+    >
+      {ASM_LEVELS.map((level) => (
+        <div
+          key={level}
+          className="min-w-0"
+        >
+          <div className="text-muted-foreground mb-2 text-xs font-medium">g++ {level}</div>
+          <div
+            className="border-border bg-background/60 max-h-96 overflow-auto rounded-md border
+              py-1"
+          >
+            {listing[level].map((fn, i) => (
+              <_AsmFunctionView
+                key={i}
+                fn={fn}
+                activeLine={line}
+                onHoverLine={setLine}
+              />
+            ))}
+          </div>
+        </div>
+      ))}
+    </div>
+  );
+}
+
+function _AsmFunctionView({
+  fn,
+  activeLine,
+  onHoverLine,
+}: {
+  fn: AsmFunction;
+  activeLine: number | null;
+  onHoverLine: (line: number | null) => void;
+}) {
+  return (
+    <div className="font-mono text-xs leading-5">
+      <div className="text-foreground truncate px-2 pt-1 font-semibold">{fn.name}:</div>
+      {fn.blocks.map(([line, text], i) => (
+        <div
+          key={i}
+          className={cn(
+            "flex gap-2 px-2",
+            line !== null && line === activeLine && "bg-primary/10",
+            line === null && "text-muted-foreground"
+          )}
+          onMouseEnter={() => onHoverLine(line)}
+        >
+          <span
+            className="text-muted-foreground w-6 shrink-0 text-right select-none"
+            title={line === null ? "Inlined library code" : `Line ${line}`}
+          >
+            {line ?? "·"}
+          </span>
+          <pre className="min-w-0 whitespace-pre">{text}</pre>
+        </div>
+      ))}
+    </div>
+  );
+}
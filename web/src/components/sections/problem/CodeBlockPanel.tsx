@@ -3,7 +3,8 @@ import * as React from "react";
 import { Gauge, Tags } from "lucide-react";
 
 import { cn } from "@/lib/utils";
-import { ProblemDifficulty } from "@/lib/problems";
+import { formatLineCount, lineCounts, lineHeat } from "@/lib/coverage";
+import { LineCountRun, ProblemDifficulty } from "@/lib/problems";
 
 import { Badge } from "@/components/ui/data_display";
 
@@ -27,6 +28,9 @@ export interface ProblemCodePanelProps extends React.ComponentProps<"section"> {
 
   /** Optional small helper text below "Program". */
   description?: string;
+
+  /** Execution counts painted in the gutter of the code (pass them only once answered). */
+  coverage?: LineCountRun[];
 }
 
 export default function ProblemCodePanel({
@@ -37,8 +41,10 @@ export default function ProblemCodePanel({
   title,
   concepts,
   description = "Read the C++ code carefully and predict the exact result (spaces and line breaks matter).",
+  coverage,
   ...props
 }: ProblemCodePanelProps) {
+  const codeRef = React.useRef<HTMLDivElement | null>(null);
   const hasMeta = revealMeta && (title || (concepts && concepts.length > 0));
 
   const difficultyColor = React.useMemo(() => {
@@ -53,6 +59,28 @@ export default function ProblemCodePanel({
     }
   }, [difficulty]);
 
+  // The code is server-rendered HTML: the counts go on its lines (tagged by `CodeHighlight`) as
+  // attributes read by the stylesheet, and come off when the code or the counts change.
+  React.useEffect(() => {
+    const lines = codeRef.current?.querySelectorAll<HTMLElement>("pre.shiki .line[data-line]");
+    if (!lines || !coverage) return;
+
+    const counts = lineCounts(coverage);
+    const hottest = Math.max(0, ...counts.values());
+    for (const line of lines) {
+      const count = counts.get(Number(line.dataset.line));
+      if (count === undefined) continue;
+      line.dataset.count = formatLineCount(count);
+      line.style.setProperty("--heat", String(lineHeat(count, hottest)));
+    }
+    return () => {
+      for (const line of lines) {
+        delete line.dataset.count;
+        line.style.removeProperty("--heat");
+      }
+    };
+  }, [children, coverage]);
+
   return (
     <section
       className={cn(
@@ -111,7 +139,17 @@ export default function ProblemCodePanel({
       ) : null}
 
       {/* Code area */}
-      <div className="border-border overflow-hidden rounded-md border">{children}</div>
+      <div
+        ref={codeRef}
+        className="border-border overflow-hidden rounded-md border"
+      >
+        {children}
+      </div>
+      {coverage && (
+        <p className="text-muted-foreground -mt-2 text-xs">
+          Gutter: how many times each line ran (gcov, -O0). Lines without a count generate no code.
+        </p>
+      )}
     </section>
   );
 }
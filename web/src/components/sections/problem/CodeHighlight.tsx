@@ -1,4 +1,4 @@
-import { getCppHighlighter } from "@/lib/shiki";
+import { getCppHighlighter, lineNumberTransformer } from "@/lib/shiki";
 
 type CodeHighlightProps = {
   code: string;
@@ -13,6 +13,7 @@ export default async function CodeHighlight({ code }: CodeHighlightProps) {
       light: "github-light",
       dark: "github-dark",
     },
+    transformers: [lineNumberTransformer],
   });
 
   return (
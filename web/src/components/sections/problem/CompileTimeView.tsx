@@ -0,0 +1,140 @@
+"use client";
+
+import { cn } from "@/lib/utils";
+import {
+  COMPILE_PHASE_LABELS,
+  type CompilePhase,
+  formatCompileSeconds,
+  formatMegabytes,
+  slowdown,
+  variantName,
+} from "@/lib/compileTime";
+import type { CompileTimeReport } from "@/lib/problems";
+
+import { RadioGroup, RadioGroupItem } from "@/components/ui/inputs";
+import { Field, FieldContent, FieldLabel, FieldTitle } from "@/components/ui/data_display";
+
+/** Answer side of the "compileTime" mode: which variant compiles fastest. */
+export function CompileTimeGuessFields({
+  labels,
+  value,
+  invalid,
+  onChange,
+}: {
+  labels: string[];
+  value: number | null;
+  /** The last attempt was wrong. */
+  invalid: boolean;
+  onChange: (variant: number) => void;
+}) {
+  return (
+    <div className="flex flex-col gap-2">
+      <p className="text-foreground text-sm">
+        Which variant (<span className="font-mono">GTO_VARIANT</span>) does g++ compile fastest?
+      </p>
+      <RadioGroup
+        value={value === null ? "" : String(value)}
+        className="w-full gap-2"
+        onValueChange={(v) => onChange(Number(v))}
+      >
+        {labels.map((label, index) => (
+          <FieldLabel
+            key={index}
+            htmlFor={`variant-${index}`}
+            aria-invalid={invalid && value === index}
+          >
+            <Field orientation="horizontal">
+              <FieldContent>
+                <FieldTitle>{variantName(index, label)}</FieldTitle>
+              </FieldContent>
+              <RadioGroupItem
+                value={String(index)}
+                id={`variant-${index}`}
+                aria-invalid={invalid && value === index}
+              />
+            </Field>
+          </FieldLabel>
+        ))}
+      </RadioGroup>
+    </div>
+  );
+}
+
+/**
+ * Review side: one bar per variant, scaled to the slowest median, with the kept samples as ticks
+ * and the phase breakdown, memory and instantiation counts below.
+ */
+export function CompileTimeBars({
+  report,
+  guess,
+}: {
+  report: CompileTimeReport;
+  guess?: number;
+}) {
+  const fastest = report.variants[report.fastest];
+  const scale = Math.max(...report.variants.flatMap((v) => [v.seconds, ...v.samples]));
+  const compiles = Math.max(...report.variants.map((v) => v.samples.length));
+
+  return (
+    <div className="flex flex-col gap-4">
+      {report.variants.map((variant, index) => (
+        <div
+          key={index}
+          className="flex flex-col gap-1.5"
+        >
+          <div className="flex flex-wrap items-baseline justify-between gap-x-3 text-sm">
+            <span className="text-foreground font-semibold">
+              {variantName(index, variant.label)}
+              {guess === index && guess !== report.fastest && (
+                <span className="ml-2 text-xs font-normal text-red-600 dark:text-red-400">
+                  your pick
+                </span>
+              )}
+            </span>
+            <span className="text-muted-foreground font-mono text-xs">
+              {formatCompileSeconds(variant.seconds)}
+              {index === report.fastest
+                ? " · fastest"
+                : ` · ${slowdown(variant, fastest).toFixed(1)}× slower`}
+            </span>
+          </div>
+
+          <div className="bg-muted relative h-3 overflow-hidden rounded-sm">
+            <div
+              className={cn(
+                "h-full rounded-sm",
+                index === report.fastest ? "bg-emerald-500/70" : "bg-amber-500/70"
+              )}
+              style={{ width: `${scale > 0 ? (variant.seconds / scale) * 100 : 0}%` }}
+            />
+            {variant.samples.map((sample, i) => (
+              <span
+                key={i}
+                title={formatCompileSeconds(sample)}
+                className="bg-foreground/60 absolute top-0 h-full w-px"
+                style={{ left: `${scale > 0 ? (sample / scale) * 100 : 0}%` }}
+              />
+            ))}
+          </div>
+
+          <div className="text-muted-foreground flex flex-wrap gap-x-4 gap-y-0.5 text-xs">
+            {(Object.keys(COMPILE_PHASE_LABELS) as CompilePhase[]).map((phase) => (
+              <span key={phase}>
+                {COMPILE_PHASE_LABELS[phase]} {formatCompileSeconds(variant[phase])}
+              </span>
+            ))}
+            <span>{formatMegabytes(variant.memory)} allocated</span>
+            {variant.classes !== null && (
+              <span>{variant.classes} class template specializations</span>
+            )}
+          </div>
+        </div>
+      ))}
+
+      <div className="text-muted-foreground text-xs">
+        Medians over up to {compiles} timed compiles per variant, after a warm-up and without
+        outliers; ticks are single compiles. Timings depend on the machine, the counts do not.
+      </div>
+    </div>
+  );
+}
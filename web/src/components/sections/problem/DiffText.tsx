@@ -1,5 +1,9 @@
 import * as React from "react";
 
+import type { DiffSpan } from "@/lib/diff";
+
+import { useTextDiff } from "@/hooks/useTextDiff";
+
 import { cn } from "../../../lib/utils";
 
 /**
@@ -13,14 +17,15 @@ const DISPLAY = {
   space: "·",
   tab: "⇥",
   eol: "↵",
+  missing: "‸",
 } as const;
 
 export type DiffCharStatus = "neutral" | "match" | "mismatch";
 
-export type DiffCharToken = {
-  char: string; // the original character (including whitespace)
-  status: DiffCharStatus;
-  isWhitespace: boolean;
+/** A maximal stretch of displayed text sharing one class name. */
+export type DiffRun = {
+  className: string;
+  text: string; // already substituted (whitespace markers, EOL markers)
 };
 
 export interface DiffTextProps {
@@ -29,7 +34,8 @@ export interface DiffTextProps {
 
   /**
    * Optional reference text to diff against (e.g. expected output).
-   * If provided, each character in `text` will be marked match/mismatch by index.
+   * If provided, characters of `text` are aligned with it (edit distance) and marked
+   * match/mismatch; places where reference characters are missing are underlined.
    */
   compareTo?: string;
 
@@ -42,31 +48,17 @@ export interface DiffTextProps {
   className?: string;
 }
 
-/**
- * Build a per-character token list.
- * Uses Array.from to iterate code points.
- */
-export function tokenizeDiff(text: string, compareTo?: string): DiffCharToken[] {
-  const source = Array.from(text);
-  const target = compareTo != null ? Array.from(compareTo) : null;
-
-  return source.map((char, index) => {
-    const isWhitespace = char === " " || char === "\t" || char === "\n";
-
-    let status: DiffCharStatus = "neutral";
-    if (target) {
-      status = index < target.length && char === target[index as number] ? "match" : "mismatch";
-    }
-
-    return { char, status, isWhitespace };
-  });
-}
+const MISSING_CLASS = "underline decoration-red-500 decoration-2";
 
-function tokenClassName(token: DiffCharToken) {
+function charClassName(status: DiffCharStatus, isWhitespace: boolean, missingBefore: boolean) {
   // Correctness has priority; otherwise whitespace is muted.
-  if (token.status === "match") return "text-emerald-500";
-  if (token.status === "mismatch") return "text-red-500";
-  if (token.isWhitespace) return "dark:text-muted-foreground/60 text-muted-foreground";
+  if (status === "match") {
+    return missingBefore ? `text-emerald-500 ${MISSING_CLASS}` : "text-emerald-500";
+  }
+  if (status === "mismatch") {
+    return missingBefore ? `text-red-500 ${MISSING_CLASS}` : "text-red-500";
+  }
+  if (isWhitespace) return "dark:text-muted-foreground/60 text-muted-foreground";
   return "text-foreground/90";
 }
 
@@ -74,70 +66,78 @@ function displayChar(char: string, showWhitespace: boolean) {
   if (!showWhitespace) return char;
   if (char === " ") return DISPLAY.space;
   if (char === "\t") return DISPLAY.tab;
+  // Newline: an EOL marker, then the real newline to keep the layout.
+  if (char === "\n") return DISPLAY.eol + "\n";
   return char;
 }
 
 /**
- * Render tokens efficiently by grouping consecutive tokens with the same className.
- * This avoids creating one <span> per character in the common case.
+ * Merge `text` into runs of consecutive characters with the same class.
+ * `spans` are the diff spans of `text` against its reference (see `diffText`), walked in step
+ * with the characters, so no per-character objects are created.
  */
-export function DiffText({ text, compareTo, showWhitespace = true, className }: DiffTextProps) {
-  const tokens = React.useMemo(() => tokenizeDiff(text, compareTo), [text, compareTo]);
-
-  const parts: React.ReactNode[] = [];
+export function buildDiffRuns(
+  text: string,
+  spans: DiffSpan[] | null,
+  showWhitespace: boolean
+): DiffRun[] {
+  const runs: DiffRun[] = [];
   let run = "";
   let runClass = "";
-  let key = 0;
-
-  const flush = () => {
-    if (!run) return;
-    parts.push(
-      <span
-        key={key++}
-        className={runClass}
-      >
-        {run}
-      </span>
-    );
-    run = "";
-  };
 
-  for (const token of tokens) {
-    const cls = tokenClassName(token);
-
-    // Newline: optionally render an EOL marker, then a real newline to keep layout.
-    if (token.char === "\n") {
-      flush();
-
-      if (showWhitespace) {
-        parts.push(
-          <span
-            key={key++}
-            className={cls}
-          >
-            {DISPLAY.eol}
-          </span>
-        );
+  let spanIndex = 0;
+  let spanLeft = 0; // characters of `text` left in the current span
+  let status: DiffCharStatus = spans ? "match" : "neutral";
+  let missingBefore = false;
+
+  // Move to the next span covering characters of `text`, noting skipped deletions. Characters
+  // past the spans (those of a diff still being computed, see `useTextDiff`) are not compared.
+  const advance = () => {
+    while (spans && spanLeft === 0 && spanIndex < spans.length) {
+      const span = spans[spanIndex++];
+      if (span.kind === "delete") {
+        missingBefore = true;
+      } else {
+        spanLeft = span.length;
+        status = span.kind === "equal" ? "match" : "mismatch";
       }
-
-      parts.push(<span key={key++}>{"\n"}</span>);
-      runClass = "";
-      continue;
     }
+    if (spanLeft === 0) status = "neutral";
+  };
 
-    const shown = displayChar(token.char, showWhitespace);
+  for (const char of text) {
+    advance();
+    if (spanLeft > 0) spanLeft--;
+
+    const isWhitespace = char === " " || char === "\t" || char === "\n";
+    const cls = charClassName(status, isWhitespace, missingBefore);
+    missingBefore = false;
 
-    if (!runClass) runClass = cls;
     if (cls !== runClass) {
-      flush();
+      if (run) runs.push({ className: runClass, text: run });
+      run = "";
       runClass = cls;
     }
-
-    run += shown;
+    run += displayChar(char, showWhitespace);
   }
 
-  flush();
+  if (run) runs.push({ className: runClass, text: run });
+
+  // Reference characters missing after the end of `text`.
+  advance();
+  if (missingBefore) runs.push({ className: "text-red-500", text: DISPLAY.missing });
 
+  return runs;
+}
+
+/** Presentational part of `DiffText`: one element per run. */
+export const DiffRunsView = React.memo(function DiffRunsView({
+  runs,
+  className,
+}: {
+  runs: DiffRun[];
+  className?: string;
+}) {
   return (
     <pre
       className={cn(
@@ -145,7 +145,39 @@ export function DiffText({ text, compareTo, showWhitespace = true, className }:
         className
       )}
     >
-      {parts}
+      {runs.map((run, i) => (
+        <span
+          key={i}
+          className={run.className}
+        >
+          {run.text}
+        </span>
+      ))}
     </pre>
   );
-}
+});
+
+/**
+ * Render `text` as runs of same-class characters (one <span> per run, not per character).
+ * Runs are memoized on (text, compareTo, showWhitespace): the diff spans only change with
+ * (text, compareTo), and the element tree is skipped entirely when no prop changed.
+ */
+export const DiffText = React.memo(function DiffText({
+  text,
+  compareTo,
+  showWhitespace = true,
+  className,
+}: DiffTextProps) {
+  const spans = useTextDiff(text, compareTo);
+  const runs = React.useMemo(
+    () => buildDiffRuns(text, spans, showWhitespace),
+    [text, spans, showWhitespace]
+  );
+
+  return (
+    <DiffRunsView
+      runs={runs}
+      className={className}
+    />
+  );
+});
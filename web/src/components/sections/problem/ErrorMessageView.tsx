@@ -1,11 +1,35 @@
+"use client";
+
+import * as React from "react";
+
+import { ChevronRight } from "lucide-react";
+
 import { cn } from "@/lib/utils";
-import { ErrorMessage, ErrorMessageColor, ErrorMessageStyle } from "@/lib/problems";
+import { type Diagnostic, groupDiagnostics } from "@/lib/diagnostics";
+import type {
+  DiagnosticSection,
+  ErrorMessage,
+  ErrorMessageColor,
+  ErrorMessageStyle,
+} from "@/lib/problems";
 
 interface ErrorMessageViewProps {
   message?: ErrorMessage;
+  /** Structure of `message` from the generator: long backtraces and notes start collapsed. */
+  sections?: DiagnosticSection[];
   className?: string;
 }
 
+/** Diagnostics rendered at mount (then on demand), so mount time does not grow with the log. */
+const DIAGNOSTICS_PAGE = 5;
+/** Backtraces and notes up to this many lines are not worth a toggle. */
+const INLINE_LINES = 2;
+/** Longer bodies are windowed: only the visible lines are in the DOM. */
+const WINDOW_MIN_LINES = 40;
+const WINDOW_VISIBLE_LINES = 16;
+const WINDOW_OVERSCAN = 8;
+const LINE_HEIGHT_PX = 24; // leading-6
+
 const colorClass: Record<ErrorMessageColor, string> = {
   default: "text-foreground",
   red: "text-red-600 dark:text-red-400",
@@ -20,10 +44,127 @@ const styleClass: Record<ErrorMessageStyle, string> = {
   italic: "font-normal italic",
 };
 
-export function ErrorMessageView({ message, className }: ErrorMessageViewProps) {
+function MessageLine({ line }: { line: ErrorMessage }) {
+  return (
+    <div className="min-h-6">
+      {line.map((part, i) => (
+        <span
+          key={i}
+          className={cn(colorClass[part.color], styleClass[part.style])}
+        >
+          {part.text}
+        </span>
+      ))}
+    </div>
+  );
+}
+
+/** Fixed-height lines (no wrapping) in a scroll box; only the lines in view are rendered. */
+function WindowedLines({ lines }: { lines: ErrorMessage[] }) {
+  const [scrollTop, setScrollTop] = React.useState(0);
+
+  const first = Math.max(0, Math.floor(scrollTop / LINE_HEIGHT_PX) - WINDOW_OVERSCAN);
+  const last = Math.min(
+    lines.length,
+    Math.ceil(scrollTop / LINE_HEIGHT_PX) + WINDOW_VISIBLE_LINES + WINDOW_OVERSCAN
+  );
+
+  return (
+    <div
+      className="overflow-auto whitespace-pre"
+      style={{ height: WINDOW_VISIBLE_LINES * LINE_HEIGHT_PX }}
+      onScroll={(e) => setScrollTop(e.currentTarget.scrollTop)}
+    >
+      <div
+        className="relative"
+        style={{ height: lines.length * LINE_HEIGHT_PX }}
+      >
+        <div
+          className="absolute inset-x-0"
+          style={{ top: first * LINE_HEIGHT_PX }}
+        >
+          {lines.slice(first, last).map((line, i) => (
+            <MessageLine
+              key={first + i}
+              line={line}
+            />
+          ))}
+        </div>
+      </div>
+    </div>
+  );
+}
+
+function Lines({ lines }: { lines: ErrorMessage[] }) {
+  if (lines.length >= WINDOW_MIN_LINES) return <WindowedLines lines={lines} />;
+  return lines.map((line, i) => (
+    <MessageLine
+      key={i}
+      line={line}
+    />
+  ));
+}
+
+/** Lines hidden behind a toggle; they are only rendered once expanded. */
+function Collapsible({ label, lines }: { label: string; lines: ErrorMessage[] }) {
+  const [open, setOpen] = React.useState(false);
+
+  if (lines.length <= INLINE_LINES) return <Lines lines={lines} />;
+
+  return (
+    <div className="text-muted-foreground">
+      <button
+        type="button"
+        className="hover:text-foreground flex items-center gap-1 font-sans text-xs"
+        aria-expanded={open}
+        onClick={() => setOpen((o) => !o)}
+      >
+        <ChevronRight className={cn("h-3 w-3 transition-transform", open && "rotate-90")} />
+        {lines.length} lines of {label}
+      </button>
+      {open && (
+        <div className="border-border ml-1.5 border-l pl-3">
+          <Lines lines={lines} />
+        </div>
+      )}
+    </div>
+  );
+}
+
+function DiagnosticView({ diagnostic }: { diagnostic: Diagnostic }) {
+  return (
+    <div>
+      {diagnostic.backtrace.length > 0 && (
+        <Collapsible
+          label="context"
+          lines={diagnostic.backtrace}
+        />
+      )}
+      <Lines lines={diagnostic.lines} />
+      {diagnostic.notes.length > 0 && (
+        <Collapsible
+          label="notes"
+          lines={diagnostic.notes}
+        />
+      )}
+    </div>
+  );
+}
+
+export function ErrorMessageView({ message, sections, className }: ErrorMessageViewProps) {
+  const diagnostics = React.useMemo(
+    () => (message ? groupDiagnostics(message, sections) : []),
+    [message, sections]
+  );
+  const [shown, setShown] = React.useState(DIAGNOSTICS_PAGE);
+
   if (!message || message.length === 0) {
     return <div className="text-muted-foreground text-sm italic">No error details available.</div>;
   }
+
+  const hidden = diagnostics.length - shown;
+  const errorCount = diagnostics.filter((d) => d.kind === "error").length;
+
   return (
     <div
       className={cn(
@@ -33,14 +174,22 @@ export function ErrorMessageView({ message, className }: ErrorMessageViewProps)
       )}
       role="note"
     >
-      {message.map((part, i) => (
-        <span
+      {diagnostics.slice(0, shown).map((diagnostic, i) => (
+        <DiagnosticView
           key={i}
-          className={cn(colorClass[part.color], styleClass[part.style])}
-        >
-          {part.text}
-        </span>
+          diagnostic={diagnostic}
+        />
       ))}
+      {hidden > 0 && (
+        <button
+          type="button"
+          className="text-muted-foreground hover:text-foreground mt-1 font-sans text-xs underline"
+          onClick={() => setShown((n) => n + DIAGNOSTICS_PAGE)}
+        >
+          Show {Math.min(hidden, DIAGNOSTICS_PAGE)} more of {hidden} remaining
+          {errorCount > 0 ? ` (${errorCount} errors in total)` : ""}
+        </button>
+      )}
     </div>
   );
 }
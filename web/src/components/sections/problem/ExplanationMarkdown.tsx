@@ -8,6 +8,10 @@ type ExplanationMarkdownProps = {
   className?: string;
 };
 
+/**
+ * Server component: explanations are compiled once per problem when the training page is
+ * rendered, and only the resulting elements reach the client (no markdown parser in the bundle).
+ */
 export function ExplanationMarkdown({ markdown, className }: ExplanationMarkdownProps) {
   return (
     <div className={cn("prose prose-zinc dark:prose-invert max-w-none text-sm", className)}>
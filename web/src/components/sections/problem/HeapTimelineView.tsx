@@ -0,0 +1,79 @@
+"use client";
+
+import { cn } from "@/lib/utils";
+import {
+  formatBytes,
+  heapEventLabel,
+  heapTimelineRows,
+  heapTimelineRowTitle,
+  peakLiveBytes,
+  unreleasedBlocks,
+} from "@/lib/heap";
+import type { HeapTimeline } from "@/lib/problems";
+
+/**
+ * Review side of `heapTimeline` problems: the heap calls of the run grouped by the line of output
+ * they came before, each a bar as high as the bytes live after it (on the scale of the peak).
+ */
+export function HeapTimelineChart({ heap, stdout }: { heap: HeapTimeline; stdout?: string }) {
+  const rows = heapTimelineRows(heap.events, stdout);
+  const peak = peakLiveBytes(rows);
+  const allocations = heap.events.filter((event) => event.op === "alloc").length;
+  const unreleased = unreleasedBlocks(heap.events);
+
+  return (
+    <div className="flex flex-col gap-3">
+      {rows.map((row) => (
+        <div
+          key={row.line}
+          className="grid grid-cols-[minmax(0,1fr)_auto] items-end gap-3"
+        >
+          <div className="flex min-w-0 flex-col gap-1">
+            <div className="text-muted-foreground text-xs">{heapTimelineRowTitle(row)}</div>
+            {row.text !== null && (
+              <code className="text-foreground truncate font-mono text-xs">{row.text || " "}</code>
+            )}
+            <div className="flex flex-wrap gap-x-3 gap-y-0.5 font-mono text-xs">
+              {row.events.map((event, i) => (
+                <span
+                  key={i}
+                  className={
+                    event.op === "alloc"
+                      ? "text-emerald-600 dark:text-emerald-400"
+                      : "text-red-600 dark:text-red-400"
+                  }
+                >
+                  {heapEventLabel(event)}
+                </span>
+              ))}
+            </div>
+          </div>
+
+          <div
+            className="bg-muted flex h-10 items-end gap-0.5 rounded-sm px-1"
+            aria-hidden
+          >
+            {row.events.map((event, i) => (
+              <span
+                key={i}
+                title={`${heapEventLabel(event)}: ${formatBytes(event.live)} live`}
+                className={cn(
+                  "w-2 rounded-t-sm",
+                  event.op === "alloc" ? "bg-emerald-500/70" : "bg-red-500/70"
+                )}
+                style={{ height: `${peak > 0 ? Math.max((event.live / peak) * 100, 4) : 4}%` }}
+              />
+            ))}
+          </div>
+        </div>
+      ))}
+
+      <div className="text-muted-foreground text-xs">
+        {allocations} allocation{allocations === 1 ? "" : "s"}, at most {formatBytes(peak)} live
+        {unreleased > 0 ? `, ${unreleased} never released` : ", all released"}. Bars are the bytes
+        live after each call to operator new or delete.
+        {heap.truncated && " The run made more heap calls than were recorded."}
+      </div>
+    </div>
+  );
+}
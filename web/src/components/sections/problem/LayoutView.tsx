@@ -0,0 +1,191 @@
+"use client";
+
+import { cn } from "@/lib/utils";
+import {
+  CACHE_LINE_BYTES,
+  type LayoutGuess,
+  elementsPerCacheLine,
+  layoutByteOwners,
+  paddingBytes,
+} from "@/lib/layout";
+import type { RecordLayout } from "@/lib/problems";
+
+import { NumericStepper } from "@/components/ui/inputs";
+
+const BYTES_PER_ROW = 16;
+
+const memberClass = [
+  "bg-sky-500/70",
+  "bg-emerald-500/70",
+  "bg-amber-500/70",
+  "bg-violet-500/70",
+  "bg-rose-500/70",
+  "bg-teal-500/70",
+];
+
+/** Answer side of the "layout" mode: one `sizeof` stepper per struct. */
+export function LayoutGuessFields({
+  layouts,
+  guess,
+  mismatches,
+  onChange,
+}: {
+  layouts: RecordLayout[];
+  guess: LayoutGuess;
+  /** Structs wrong at the last attempt (empty before any attempt). */
+  mismatches: string[];
+  onChange: (guess: LayoutGuess) => void;
+}) {
+  return (
+    <div className="grid gap-2 sm:grid-cols-2">
+      {layouts.map(({ name }) => (
+        <div
+          key={name}
+          className={cn(
+            "bg-background/60 flex items-center justify-between gap-3 rounded-md border px-3 py-2",
+            mismatches.includes(name) && "border-red-500/50"
+          )}
+        >
+          <span className="text-foreground font-mono text-sm">sizeof({name})</span>
+          <NumericStepper
+            value={guess[name] ?? 0}
+            min={0}
+            onChange={(next) => onChange({ ...guess, [name]: next })}
+            ariaLabel={`sizeof(${name})`}
+          />
+        </div>
+      ))}
+    </div>
+  );
+}
+
+/**
+ * Review side: a byte map of every struct (members, padding, cache line boundaries), and the
+ * measured hot loop throughput when the generator timed it.
+ */
+export function LayoutByteMaps({
+  layouts,
+  guess,
+}: {
+  layouts: RecordLayout[];
+  guess?: LayoutGuess;
+}) {
+  const fastest = Math.min(...layouts.map((layout) => layout.nsPerElement ?? Infinity));
+
+  return (
+    <div className="flex flex-col gap-4">
+      {layouts.map((layout) => (
+        <_LayoutByteMap
+          key={layout.name}
+          layout={layout}
+          guessedSize={guess?.[layout.name]}
+          slowdown={
+            layout.nsPerElement !== undefined && Number.isFinite(fastest)
+              ? layout.nsPerElement / fastest
+              : undefined
+          }
+        />
+      ))}
+    </div>
+  );
+}
+
+function _LayoutByteMap({
+  layout,
+  guessedSize,
+  slowdown,
+}: {
+  layout: RecordLayout;
+  guessedSize?: number;
+  slowdown?: number;
+}) {
+  const owners = layoutByteOwners(layout);
+  const rows: number[][] = [];
+  for (let start = 0; start < owners.length; start += BYTES_PER_ROW) {
+    rows.push(owners.slice(start, start + BYTES_PER_ROW));
+  }
+  const padding = paddingBytes(layout);
+  const perLine = elementsPerCacheLine(layout);
+
+  return (
+    <div className="flex flex-col gap-2">
+      <div className="flex flex-wrap items-baseline justify-between gap-x-3 text-sm">
+        <span className="text-foreground font-mono font-semibold">
+          sizeof({layout.name}) = {layout.size}
+          {guessedSize !== undefined && guessedSize !== layout.size && (
+            <span className="ml-2 font-sans text-xs font-normal text-red-600 dark:text-red-400">
+              your guess: {guessedSize}
+            </span>
+          )}
+        </span>
+        <span className="text-muted-foreground text-xs">
+          alignof {layout.align} · {padding} padding byte{padding === 1 ? "" : "s"} ·{" "}
+          {Number.isInteger(perLine) ? perLine : perLine.toFixed(2)} per cache line
+        </span>
+      </div>
+
+      <div className="flex flex-col gap-0.5 font-mono text-[10px] leading-4">
+        {rows.map((row, r) => {
+          const start = r * BYTES_PER_ROW;
+          return (
+            <div key={start}>
+              {start > 0 && start % CACHE_LINE_BYTES === 0 && (
+                <div
+                  className="text-muted-foreground my-1 border-t border-dashed border-current
+                    pt-0.5"
+                >
+                  cache line {start / CACHE_LINE_BYTES + 1}
+                </div>
+              )}
+              <div className="flex items-center gap-1">
+                <span className="text-muted-foreground w-6 shrink-0 text-right">{start}</span>
+                <div className="grid flex-1 grid-cols-16 gap-px">
+                  {row.map((owner, i) => (
+                    <span
+                      key={i}
+                      title={
+                        owner === -1
+                          ? `byte ${start + i}: padding`
+                          : `byte ${start + i}: ${layout.members[owner as number].name}`
+                      }
+                      className={cn(
+                        "h-4 rounded-[2px]",
+                        owner === -1
+                          ? "bg-muted-foreground/15 border border-dashed"
+                          : memberClass[owner % memberClass.length]
+                      )}
+                    />
+                  ))}
+                </div>
+              </div>
+            </div>
+          );
+        })}
+      </div>
+
+      <ul className="flex flex-wrap gap-x-4 gap-y-1 text-xs">
+        {layout.members.map((member, i) => (
+          <li
+            key={member.name}
+            className="flex items-center gap-1.5"
+          >
+            <span
+              className={cn("h-2.5 w-2.5 rounded-[2px]", memberClass[i % memberClass.length])}
+            />
+            <span className="font-mono">{member.name}</span>
+            <span className="text-muted-foreground">
+              offset {member.offset}, {member.size} B, align {member.align}
+            </span>
+          </li>
+        ))}
+      </ul>
+
+      {layout.nsPerElement !== undefined && (
+        <div className="text-muted-foreground text-xs">
+          Hot loop over an array: {layout.nsPerElement.toFixed(2)} ns per element
+          {slowdown !== undefined && slowdown > 1.05 && ` (${slowdown.toFixed(1)}× the fastest)`}
+        </div>
+      )}
+    </div>
+  );
+}
@@ -0,0 +1,94 @@
+"use client";
+
+import { cn } from "@/lib/utils";
+import {
+  GUESSED_LIFECYCLE_COUNTERS,
+  LIFECYCLE_COUNTER_LABELS,
+  type LifecycleGuess,
+} from "@/lib/lifecycle";
+import type { LifecycleCounter, LifecycleCounts } from "@/lib/problems";
+
+import { NumericStepper } from "@/components/ui/inputs";
+
+/** Answer side of the "lifecycle" mode: one stepper per guessed counter. */
+export function LifecycleGuessFields({
+  guess,
+  mismatches,
+  onChange,
+}: {
+  guess: LifecycleGuess;
+  /** Counters wrong at the last attempt (empty before any attempt). */
+  mismatches: LifecycleCounter[];
+  onChange: (guess: LifecycleGuess) => void;
+}) {
+  return (
+    <div className="grid gap-2 sm:grid-cols-2">
+      {GUESSED_LIFECYCLE_COUNTERS.map((name) => (
+        <div
+          key={name}
+          className={cn(
+            "bg-background/60 flex items-center justify-between gap-3 rounded-md border px-3 py-2",
+            mismatches.includes(name) && "border-red-500/50"
+          )}
+        >
+          <span className="text-foreground text-sm">{LIFECYCLE_COUNTER_LABELS[name]}</span>
+          <NumericStepper
+            value={guess[name] ?? 0}
+            min={0}
+            onChange={(next) => onChange({ ...guess, [name]: next })}
+            ariaLabel={LIFECYCLE_COUNTER_LABELS[name]}
+          />
+        </div>
+      ))}
+    </div>
+  );
+}
+
+/** Review side: every traced counter, next to the player's guess when there is one. */
+export function LifecycleCountsTable({
+  expected,
+  guess,
+}: {
+  expected: LifecycleCounts;
+  guess?: LifecycleGuess;
+}) {
+  const counters = Object.keys(LIFECYCLE_COUNTER_LABELS) as LifecycleCounter[];
+
+  return (
+    <table className="w-full text-sm">
+      <thead className="text-muted-foreground text-xs">
+        <tr>
+          <th className="py-1 text-left font-medium">gto::Traced calls</th>
+          <th className="py-1 text-right font-medium">Count</th>
+          {guess && <th className="py-1 text-right font-medium">Your guess</th>}
+        </tr>
+      </thead>
+      <tbody className="font-mono">
+        {counters.map((name) => {
+          const guessed = guess?.[name];
+          return (
+            <tr
+              key={name}
+              className="border-border border-t"
+            >
+              <td className="py-1 font-sans">{LIFECYCLE_COUNTER_LABELS[name]}</td>
+              <td className="py-1 text-right">{expected[name]}</td>
+              {guess && (
+                <td
+                  className={cn(
+                    "py-1 text-right",
+                    guessed !== undefined && guessed !== expected[name]
+                      ? "text-red-600 dark:text-red-400"
+                      : "text-muted-foreground"
+                  )}
+                >
+                  {guessed ?? "—"}
+                </td>
+              )}
+            </tr>
+          );
+        })}
+      </tbody>
+    </table>
+  );
+}
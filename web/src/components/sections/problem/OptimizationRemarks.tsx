@@ -0,0 +1,86 @@
+"use client";
+
+import { cn } from "@/lib/utils";
+import { optimizationAnswerText, optimizationQuestionText } from "@/lib/optimization";
+import type { OptimizationQuestion, OptimizationRemark } from "@/lib/problems";
+
+import { RadioGroup, RadioGroupItem } from "@/components/ui/inputs";
+import { Field, FieldContent, FieldLabel, FieldTitle } from "@/components/ui/data_display";
+
+/** Answer side of the "optimization" mode: yes or no to the question. */
+export function OptimizationGuessFields({
+  question,
+  value,
+  invalid,
+  onChange,
+}: {
+  question: OptimizationQuestion;
+  value: boolean | null;
+  /** The last attempt was wrong. */
+  invalid: boolean;
+  onChange: (optimized: boolean) => void;
+}) {
+  return (
+    <div className="flex flex-col gap-2">
+      <p className="text-foreground text-sm">{optimizationQuestionText(question)}</p>
+      <RadioGroup
+        value={value === null ? "" : String(value)}
+        className="w-full gap-2 sm:grid-cols-2"
+        onValueChange={(v) => onChange(v === "true")}
+      >
+        {[true, false].map((optimized) => (
+          <FieldLabel
+            key={String(optimized)}
+            htmlFor={`optimized-${optimized}`}
+            aria-invalid={invalid && value === optimized}
+          >
+            <Field orientation="horizontal">
+              <FieldContent>
+                <FieldTitle>{optimizationAnswerText(question, optimized)}</FieldTitle>
+              </FieldContent>
+              <RadioGroupItem
+                value={String(optimized)}
+                id={`optimized-${optimized}`}
+                aria-invalid={invalid && value === optimized}
+              />
+            </Field>
+          </FieldLabel>
+        ))}
+      </RadioGroup>
+    </div>
+  );
+}
+
+const kindClass: Record<OptimizationRemark["kind"], string> = {
+  optimized: "text-emerald-600 dark:text-emerald-400",
+  missed: "text-amber-600 dark:text-amber-400",
+};
+
+/** Review side: what the optimizer reported, line by line; the asked line stands out. */
+export function RemarksList({
+  remarks,
+  highlightLine,
+}: {
+  remarks: OptimizationRemark[];
+  highlightLine?: number;
+}) {
+  return (
+    <ul className="flex flex-col font-mono text-xs leading-5">
+      {remarks.map((remark, i) => (
+        <li
+          key={i}
+          className={cn(
+            "flex gap-2 rounded-sm px-1",
+            remark.line === highlightLine ? "bg-primary/10" : "text-muted-foreground"
+          )}
+        >
+          <span className="w-14 shrink-0 text-right">
+            {remark.line}:{remark.column}
+          </span>
+          <span className={cn("w-16 shrink-0", kindClass[remark.kind])}>{remark.kind}</span>
+          <span className="min-w-0 break-words">{remark.message}</span>
+        </li>
+      ))}
+    </ul>
+  );
+}
@@ -6,13 +6,38 @@ import {
   AlertCircleIcon,
   AlertTriangle,
   ChevronRight,
+  Copy,
+  Hourglass,
+  Gauge,
   Keyboard,
+  ListChecks,
+  Ruler,
   Terminal,
   Wrench,
 } from "lucide-react";
 
 import { cn } from "@/lib/utils";
-import { ErrorType } from "@/lib/problems";
+import { variantName } from "@/lib/compileTime";
+import { PERF_MARKS, markPerf } from "@/lib/perf";
+import {
+  LIFECYCLE_COUNTER_LABELS,
+  type LifecycleGuess,
+  emptyLifecycleGuess,
+  lifecycleMismatches,
+} from "@/lib/lifecycle";
+import { type LayoutGuess, emptyLayoutGuess, layoutMismatches } from "@/lib/layout";
+import { optimizationAnswerText } from "@/lib/optimization";
+import { inlineStdout, outputsMismatches } from "@/lib/schedules";
+import type {
+  AnswerMode,
+  CompileTimeReport,
+  ErrorType,
+  LifecycleCounter,
+  LifecycleCounts,
+  OptimizationQuestion,
+  RecordLayout,
+  ScheduleExploration,
+} from "@/lib/problems";
 
 import { DiffText } from "@/components/sections/problem/DiffText";
 import { Alert, AlertDescription, AlertTitle } from "@/components/ui/feedback";
@@ -26,6 +51,11 @@ import {
   FieldTitle,
 } from "@/components/ui/data_display";
 
+import { CompileTimeGuessFields } from "./CompileTimeView";
+import { LayoutGuessFields } from "./LayoutView";
+import { LifecycleGuessFields } from "./LifecycleCounts";
+import { OptimizationGuessFields } from "./OptimizationRemarks";
+import { OutputChoicesFields } from "./ScheduleOutputs";
 import { SubmissionEvaluation } from "./ProblemWorkspace";
 
 type ValidationResult = {
@@ -34,6 +64,9 @@ type ValidationResult = {
   // Useful booleans for UI decisions
   errorTypeMatches: boolean;
   outputMatches: boolean;
+  lifecycleMismatches?: LifecycleCounter[];
+  layoutMismatches?: string[];
+  outputsMismatches?: string[];
 };
 
 type OutputGuessPanelProps = {
@@ -47,6 +80,15 @@ type OutputGuessPanelProps = {
   stdin?: string;
   expectedErrorType?: ErrorType;
   expectedStdout?: string;
+
+  answerMode?: AnswerMode;
+  expectedLifecycle?: LifecycleCounts;
+  optimization?: OptimizationQuestion;
+  expectedOptimized?: boolean | null;
+  expectedLayout?: RecordLayout[];
+  choices?: string[];
+  expectedSchedules?: ScheduleExploration;
+  expectedCompileTime?: CompileTimeReport;
 };
 
 const ERROR_TYPE_META: Record<
@@ -114,6 +156,53 @@ function validateGuess(params: {
   return { ok, reasons, errorTypeMatches, outputMatches };
 }
 
+function validateLayoutGuess(guess: LayoutGuess, expected: RecordLayout[]): ValidationResult {
+  const mismatches = layoutMismatches(guess, expected);
+  const ok = mismatches.length === 0;
+  const reasons = ok
+    ? ["Perfect match: every size, padding included."]
+    : [`Wrong size: ${mismatches.map((name) => `sizeof(${name})`).join(", ")}.`];
+
+  return { ok, reasons, errorTypeMatches: true, outputMatches: ok, layoutMismatches: mismatches };
+}
+
+function validateOutputsGuess(
+  selected: string[],
+  choices: string[],
+  schedules: ScheduleExploration
+): ValidationResult {
+  const mismatches = outputsMismatches(selected, choices, schedules);
+  const ok = mismatches.length === 0;
+  const reasons = ok
+    ? ["Perfect match: exactly the outputs the explored schedules produced."]
+    : [
+        `Wrong set: ${mismatches.map((choice) => `"${inlineStdout(choice)}"`).join(", ")} ${
+          mismatches.length === 1 ? "is" : "are"
+        } misjudged.`,
+      ];
+
+  return { ok, reasons, errorTypeMatches: true, outputMatches: ok, outputsMismatches: mismatches };
+}
+
+function validateLifecycleGuess(
+  guess: LifecycleGuess,
+  expected: LifecycleCounts
+): ValidationResult {
+  const mismatches = lifecycleMismatches(guess, expected);
+  const ok = mismatches.length === 0;
+  const reasons = ok
+    ? ["Perfect match: every copy and move is accounted for."]
+    : [`Wrong count: ${mismatches.map((name) => LIFECYCLE_COUNTER_LABELS[name]).join(", ")}.`];
+
+  return {
+    ok,
+    reasons,
+    errorTypeMatches: true,
+    outputMatches: ok,
+    lifecycleMismatches: mismatches,
+  };
+}
+
 export function OutputGuessPanel({
   onSubmit,
   maxAttempts,
@@ -123,14 +212,41 @@ export function OutputGuessPanel({
   stdin,
   expectedErrorType = "no-error",
   expectedStdout = "",
+  answerMode = "output",
+  expectedLifecycle,
+  optimization,
+  expectedOptimized,
+  expectedLayout,
+  choices,
+  expectedSchedules,
+  expectedCompileTime,
 }: OutputGuessPanelProps) {
   const [typedStdout, setTypedStdout] = React.useState("");
   const [selectedErrorType, setSelectedErrorType] = React.useState<ErrorType>("no-error");
+  const [lifecycleGuess, setLifecycleGuess] = React.useState(emptyLifecycleGuess);
+  const [optimizedGuess, setOptimizedGuess] = React.useState<boolean | null>(null);
+  const [layoutGuess, setLayoutGuess] = React.useState(() =>
+    emptyLayoutGuess(expectedLayout ?? [])
+  );
+  const [fastestGuess, setFastestGuess] = React.useState<number | null>(null);
+  const [selectedOutputs, setSelectedOutputs] = React.useState<string[]>([]);
   const [lastValidation, setLastValidation] = React.useState<ValidationResult | null>(null);
 
+  // Without the data to check the answer (e.g. the program did not compile or run), fall back
+  // to guessing the output.
+  const guessLifecycle = answerMode === "lifecycle" && expectedLifecycle !== undefined;
+  const guessOptimization =
+    answerMode === "optimization" && optimization !== undefined && expectedOptimized != null;
+  const guessLayout = answerMode === "layout" && expectedLayout !== undefined;
+  const guessOutputs =
+    answerMode === "outputs" && choices !== undefined && expectedSchedules !== undefined;
+  const guessCompileTime = answerMode === "compileTime" && expectedCompileTime !== undefined;
+
   const taRef = React.useRef<HTMLTextAreaElement | null>(null);
   const overlayRef = React.useRef<HTMLDivElement | null>(null);
 
+  React.useEffect(() => markPerf(PERF_MARKS.answerReady), []);
+
   const canTypeStdout = selectedErrorType === "no-error";
   const shouldDiffStdout =
     showOutputHints &&
@@ -166,7 +282,124 @@ export function OutputGuessPanel({
     [resetFeedback]
   );
 
+  const handleLifecycleChange = React.useCallback(
+    (guess: LifecycleGuess) => {
+      setLifecycleGuess(guess);
+      resetFeedback();
+    },
+    [resetFeedback]
+  );
+
+  const handleLayoutChange = React.useCallback(
+    (guess: LayoutGuess) => {
+      setLayoutGuess(guess);
+      resetFeedback();
+    },
+    [resetFeedback]
+  );
+
+  const handleOutputsChange = React.useCallback(
+    (selected: string[]) => {
+      setSelectedOutputs(selected);
+      resetFeedback();
+    },
+    [resetFeedback]
+  );
+
+  const handleFastestChange = React.useCallback(
+    (variant: number) => {
+      setFastestGuess(variant);
+      resetFeedback();
+    },
+    [resetFeedback]
+  );
+
+  const handleOptimizedChange = React.useCallback(
+    (optimized: boolean) => {
+      setOptimizedGuess(optimized);
+      resetFeedback();
+    },
+    [resetFeedback]
+  );
+
   const submitAttempt = React.useCallback(() => {
+    if (guessOptimization) {
+      const ok = optimizedGuess === expectedOptimized;
+      const expected = optimizationAnswerText(optimization!, expectedOptimized!);
+      const result: ValidationResult = {
+        ok,
+        reasons: [
+          ok
+            ? `Right: ${expected.toLowerCase()}, as the compiler remarks report.`
+            : "Wrong answer: the compiler remarks do not agree.",
+        ],
+        errorTypeMatches: true,
+        outputMatches: ok,
+      };
+      setLastValidation(result);
+      onSubmit({
+        success: ok,
+        summary: result.reasons[0],
+        submission: { errorType: expectedErrorType, optimized: optimizedGuess ?? undefined },
+      });
+      return;
+    }
+
+    if (guessCompileTime) {
+      const { fastest, variants } = expectedCompileTime!;
+      const ok = fastestGuess === fastest;
+      const result: ValidationResult = {
+        ok,
+        reasons: [
+          ok
+            ? `Right: ${variantName(fastest, variants[fastest].label)} compiles fastest.`
+            : "Wrong variant: another one compiles faster.",
+        ],
+        errorTypeMatches: true,
+        outputMatches: ok,
+      };
+      setLastValidation(result);
+      onSubmit({
+        success: ok,
+        summary: result.reasons[0],
+        submission: { errorType: expectedErrorType, fastestVariant: fastestGuess ?? undefined },
+      });
+      return;
+    }
+
+    if (guessLayout) {
+      const result = validateLayoutGuess(layoutGuess, expectedLayout!);
+      setLastValidation(result);
+      onSubmit({
+        success: result.ok,
+        summary: result.reasons[0],
+        submission: { errorType: expectedErrorType, layout: layoutGuess },
+      });
+      return;
+    }
+
+    if (guessOutputs) {
+      const result = validateOutputsGuess(selectedOutputs, choices!, expectedSchedules!);
+      setLastValidation(result);
+      onSubmit({
+        success: result.ok,
+        summary: result.reasons[0],
+        submission: { errorType: expectedErrorType, outputs: selectedOutputs },
+      });
+      return;
+    }
+
+    if (guessLifecycle) {
+      const result = validateLifecycleGuess(lifecycleGuess, expectedLifecycle!);
+      setLastValidation(result);
+      onSubmit({
+        success: result.ok,
+        summary: result.reasons[0],
+        submission: { errorType: expectedErrorType, lifecycle: lifecycleGuess },
+      });
+      return;
+    }
+
     const result = validateGuess({
       selectedErrorType,
       typedStdout,
@@ -184,7 +417,30 @@ export function OutputGuessPanel({
         stdout: typedStdout,
       },
     });
-  }, [expectedErrorType, expectedStdout, onSubmit, selectedErrorType, typedStdout]);
+  }, [
+    choices,
+    expectedCompileTime,
+    expectedErrorType,
+    expectedLayout,
+    expectedLifecycle,
+    expectedOptimized,
+    expectedSchedules,
+    expectedStdout,
+    fastestGuess,
+    guessCompileTime,
+    guessLayout,
+    guessLifecycle,
+    guessOptimization,
+    guessOutputs,
+    layoutGuess,
+    lifecycleGuess,
+    onSubmit,
+    optimization,
+    optimizedGuess,
+    selectedErrorType,
+    selectedOutputs,
+    typedStdout,
+  ]);
 
   const giveUp = React.useCallback(() => {
     onSubmit({
@@ -195,11 +451,33 @@ export function OutputGuessPanel({
   }, [onSubmit]);
 
   const hintText = React.useMemo(() => {
+    if (guessOptimization) {
+      return "Predict what the optimizer does (GCC at -O2), as reported by its remarks.";
+    }
+    if (guessCompileTime) {
+      return "Guess which variant g++ compiles fastest (-O2, warm cache, median of several runs).";
+    }
+    if (guessLayout) {
+      return "Give the size of each struct on x86-64 (GCC), padding included.";
+    }
+    if (guessOutputs) {
+      return "Select every output some thread interleaving can print.";
+    }
+    if (guessLifecycle) {
+      return "Count the calls made on the gto::Traced objects over the whole run.";
+    }
     if (selectedErrorType !== "no-error") {
       return "Stdout input is disabled because you selected an error outcome.";
     }
     return "Type the exact stdout (spaces and line breaks matter). Tip: Ctrl/⌘ + Enter to submit.";
-  }, [selectedErrorType]);
+  }, [
+    guessCompileTime,
+    guessLayout,
+    guessLifecycle,
+    guessOptimization,
+    guessOutputs,
+    selectedErrorType,
+  ]);
 
   const attemptsRemaining = React.useMemo(
     () => Math.max(0, (maxAttempts || 0) - currentAttempts),
@@ -258,128 +536,198 @@ export function OutputGuessPanel({
         )}
       </section>
 
-      {/* Outcome selection */}
-      <section className="flex flex-col gap-2">
-        <div className="text-foreground flex items-center gap-2 text-sm font-semibold">
-          <Terminal className="h-4 w-4" />
-          <span>Program outcome</span>
-        </div>
-
-        <RadioGroup
-          value={selectedErrorType}
-          className="w-full gap-2"
-          onValueChange={(v) => handleErrorTypeChange(v as ErrorType)}
-        >
-          {(Object.keys(ERROR_TYPE_META) as ErrorType[]).map((key, idx) => {
-            const meta = ERROR_TYPE_META[key as ErrorType];
-            const invalid =
-              lastValidation != null &&
-              selectedErrorType === (key as ErrorType) &&
-              expectedErrorType !== (key as ErrorType);
-
-            return (
-              <FieldLabel
-                key={key}
-                htmlFor={key}
-                className={cn(idx > 0 && "mt-2")}
-                aria-invalid={invalid}
-              >
-                <Field orientation="horizontal">
-                  <div
-                    className={cn(
-                      `text-muted-foreground bg-background/60 mt-0.5 flex h-9 w-9 items-center
-                      justify-center rounded-md border`
-                    )}
-                  >
-                    <meta.Icon className="h-4 w-4" />
-                  </div>
-
-                  <FieldContent>
-                    <FieldTitle>{meta.label}</FieldTitle>
-                    <FieldDescription>{meta.description}</FieldDescription>
-                  </FieldContent>
-
-                  <RadioGroupItem
-                    value={key}
-                    id={key}
-                    aria-invalid={invalid}
-                  />
-                </Field>
-              </FieldLabel>
-            );
-          })}
-        </RadioGroup>
-      </section>
-
-      {/* Stdout entry (overlay + textarea) */}
-      <section className="flex flex-col gap-2">
-        <div className="text-foreground flex items-center gap-2 text-sm font-semibold">
-          <ChevronRight className="h-4 w-4" />
-          <span>Output (stdout)</span>
-        </div>
-
-        <div className="relative w-full">
-          {/* Overlay (visual layer) */}
-          <div
-            ref={overlayRef}
-            aria-hidden="true"
-            className={cn(
-              `bg-background text-foreground/90 pointer-events-none absolute inset-0 overflow-auto
-              rounded-md border px-3 py-2`,
-              !canTypeStdout && "opacity-60"
-            )}
-          >
-            <DiffText
-              text={typedStdout}
-              compareTo={shouldDiffStdout ? expectedStdout : undefined}
-            />
+      {guessOptimization ? (
+        <section className="flex flex-col gap-2">
+          <div className="text-foreground flex items-center gap-2 text-sm font-semibold">
+            <Gauge className="h-4 w-4" />
+            <span>Optimization</span>
           </div>
-
-          {/* Textarea (editing layer) */}
-          <Textarea
-            ref={taRef}
-            value={typedStdout}
-            placeholder={canTypeStdout ? "Type the exact stdout here…" : "Stdout not applicable."}
-            title={canTypeStdout ? "Type the exact stdout here…" : "Stdout not applicable."}
-            onChange={(e) => handleStdoutChange(e.target.value)}
-            onScroll={syncScroll}
-            onKeyDown={(e) => {
-              const isSubmit = (e.ctrlKey || e.metaKey) && e.key === "Enter";
-              if (isSubmit) {
-                e.preventDefault();
-                submitAttempt();
-              }
-            }}
-            spellCheck={false}
-            disabled={!canTypeStdout}
-            aria-disabled={!canTypeStdout}
-            aria-invalid={
-              lastValidation != null &&
-              selectedErrorType === "no-error" &&
-              expectedErrorType === "no-error" &&
-              typedStdout !== expectedStdout
-            }
-            className={cn(
-              "relative z-10 block min-h-20 w-full resize-y rounded-md border px-3 py-2",
-              "font-mono text-sm leading-6",
-              "caret-foreground selection:bg-primary/25 text-transparent",
-              "tracking-widest"
-            )}
+          <OptimizationGuessFields
+            question={optimization!}
+            value={optimizedGuess}
+            invalid={lastValidation != null && !lastValidation.ok}
+            onChange={handleOptimizedChange}
           />
-        </div>
+        </section>
+      ) : guessCompileTime ? (
+        <section className="flex flex-col gap-2">
+          <div className="text-foreground flex items-center gap-2 text-sm font-semibold">
+            <Hourglass className="h-4 w-4" />
+            <span>Compile time</span>
+          </div>
+          <CompileTimeGuessFields
+            labels={expectedCompileTime!.variants.map((variant) => variant.label)}
+            value={fastestGuess}
+            invalid={lastValidation != null && !lastValidation.ok}
+            onChange={handleFastestChange}
+          />
+        </section>
+      ) : guessLayout ? (
+        <section className="flex flex-col gap-2">
+          <div className="text-foreground flex items-center gap-2 text-sm font-semibold">
+            <Ruler className="h-4 w-4" />
+            <span>Struct sizes</span>
+          </div>
+          <LayoutGuessFields
+            layouts={expectedLayout!}
+            guess={layoutGuess}
+            mismatches={lastValidation?.layoutMismatches ?? []}
+            onChange={handleLayoutChange}
+          />
+        </section>
+      ) : guessOutputs ? (
+        <section className="flex flex-col gap-2">
+          <div className="text-foreground flex items-center gap-2 text-sm font-semibold">
+            <ListChecks className="h-4 w-4" />
+            <span>Possible outputs</span>
+          </div>
+          <OutputChoicesFields
+            choices={choices!}
+            selected={selectedOutputs}
+            mismatches={lastValidation?.outputsMismatches ?? []}
+            onChange={handleOutputsChange}
+          />
+        </section>
+      ) : guessLifecycle ? (
+        <section className="flex flex-col gap-2">
+          <div className="text-foreground flex items-center gap-2 text-sm font-semibold">
+            <Copy className="h-4 w-4" />
+            <span>Copies and moves</span>
+          </div>
+          <LifecycleGuessFields
+            guess={lifecycleGuess}
+            mismatches={lastValidation?.lifecycleMismatches ?? []}
+            onChange={handleLifecycleChange}
+          />
+        </section>
+      ) : (
+        <>
+          {/* Outcome selection */}
+          <section className="flex flex-col gap-2">
+            <div className="text-foreground flex items-center gap-2 text-sm font-semibold">
+              <Terminal className="h-4 w-4" />
+              <span>Program outcome</span>
+            </div>
+
+            <RadioGroup
+              value={selectedErrorType}
+              className="w-full gap-2"
+              onValueChange={(v) => handleErrorTypeChange(v as ErrorType)}
+            >
+              {(Object.keys(ERROR_TYPE_META) as ErrorType[]).map((key, idx) => {
+                const meta = ERROR_TYPE_META[key as ErrorType];
+                const invalid =
+                  lastValidation != null &&
+                  selectedErrorType === (key as ErrorType) &&
+                  expectedErrorType !== (key as ErrorType);
+
+                return (
+                  <FieldLabel
+                    key={key}
+                    htmlFor={key}
+                    className={cn(idx > 0 && "mt-2")}
+                    aria-invalid={invalid}
+                  >
+                    <Field orientation="horizontal">
+                      <div
+                        className={cn(
+                          `text-muted-foreground bg-background/60 mt-0.5 flex h-9 w-9 items-center
+                          justify-center rounded-md border`
+                        )}
+                      >
+                        <meta.Icon className="h-4 w-4" />
+                      </div>
+
+                      <FieldContent>
+                        <FieldTitle>{meta.label}</FieldTitle>
+                        <FieldDescription>{meta.description}</FieldDescription>
+                      </FieldContent>
+
+                      <RadioGroupItem
+                        value={key}
+                        id={key}
+                        aria-invalid={invalid}
+                      />
+                    </Field>
+                  </FieldLabel>
+                );
+              })}
+            </RadioGroup>
+          </section>
+
+          {/* Stdout entry (overlay + textarea) */}
+          <section className="flex flex-col gap-2">
+            <div className="text-foreground flex items-center gap-2 text-sm font-semibold">
+              <ChevronRight className="h-4 w-4" />
+              <span>Output (stdout)</span>
+            </div>
+
+            <div className="relative w-full">
+              {/* Overlay (visual layer) */}
+              <div
+                ref={overlayRef}
+                aria-hidden="true"
+                className={cn(
+                  `bg-background text-foreground/90 pointer-events-none absolute inset-0
+                  overflow-auto rounded-md border px-3 py-2`,
+                  !canTypeStdout && "opacity-60"
+                )}
+              >
+                <DiffText
+                  text={typedStdout}
+                  compareTo={shouldDiffStdout ? expectedStdout : undefined}
+                />
+              </div>
+
+              {/* Textarea (editing layer) */}
+              <Textarea
+                ref={taRef}
+                value={typedStdout}
+                placeholder={
+                  canTypeStdout ? "Type the exact stdout here…" : "Stdout not applicable."
+                }
+                title={canTypeStdout ? "Type the exact stdout here…" : "Stdout not applicable."}
+                onChange={(e) => handleStdoutChange(e.target.value)}
+                onScroll={syncScroll}
+                onKeyDown={(e) => {
+                  const isSubmit = (e.ctrlKey || e.metaKey) && e.key === "Enter";
+                  if (isSubmit) {
+                    e.preventDefault();
+                    submitAttempt();
+                  }
+                }}
+                spellCheck={false}
+                disabled={!canTypeStdout}
+                aria-disabled={!canTypeStdout}
+                aria-invalid={
+                  lastValidation != null &&
+                  selectedErrorType === "no-error" &&
+                  expectedErrorType === "no-error" &&
+                  typedStdout !== expectedStdout
+                }
+                className={cn(
+                  "relative z-10 block min-h-20 w-full resize-y rounded-md border px-3 py-2",
+                  "font-mono text-sm leading-6",
+                  "caret-foreground selection:bg-primary/25 text-transparent",
+                  "tracking-widest"
+                )}
+              />
+            </div>
+          </section>
+        </>
+      )}
 
-        {/* Feedback / reasons */}
-        {feedback && showOutputHints && (
-          <Alert
-            variant="destructive"
-            className="border-red-500/30 bg-red-500/10"
-          >
-            <AlertCircleIcon />
-            <AlertTitle>{feedback.title}</AlertTitle>
-            <AlertDescription>{feedback.message}</AlertDescription>
-          </Alert>
-        )}
-      </section>
+      {/* Feedback / reasons */}
+      {feedback && showOutputHints && (
+        <Alert
+          variant="destructive"
+          className="border-red-500/30 bg-red-500/10"
+        >
+          <AlertCircleIcon />
+          <AlertTitle>{feedback.title}</AlertTitle>
+          <AlertDescription>{feedback.message}</AlertDescription>
+        </Alert>
+      )}
 
       {/* Actions */}
       <div className="mt-1 flex items-center gap-3">
@@ -389,7 +737,11 @@ export function OutputGuessPanel({
             hover:dark:bg-emerald-500`
           )}
           onClick={submitAttempt}
-          disabled={maxAttempts !== null && attemptsRemaining <= 0}
+          disabled={
+            (maxAttempts !== null && attemptsRemaining <= 0) ||
+            (guessOptimization && optimizedGuess === null) ||
+            (guessCompileTime && fastestGuess === null)
+          }
         >
           Submit
         </Button>
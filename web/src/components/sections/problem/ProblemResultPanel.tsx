@@ -7,27 +7,42 @@ import {
   ArrowRight,
   CircleCheck,
   CircleX,
+  Copy,
+  Cpu,
+  Gauge,
+  Hourglass,
   Info,
   Keyboard,
+  ListChecks,
+  MemoryStick,
   RotateCcw,
+  Ruler,
   Terminal,
 } from "lucide-react";
 
 import { cn } from "@/lib/utils";
-import { ErrorType, ProblemResult } from "@/lib/problems";
+import { optimizationAnswerText, optimizationQuestionText } from "@/lib/optimization";
+import { ErrorType, OptimizationQuestion, ProblemResult } from "@/lib/problems";
 
 import { Button } from "@/components/ui/inputs";
 import { DiffText } from "@/components/sections/problem/DiffText";
 import { Alert, AlertDescription, AlertTitle } from "@/components/ui/feedback";
 
+import { AssemblyView } from "./AssemblyView";
+import { CompileTimeBars } from "./CompileTimeView";
 import { ErrorMessageView } from "./ErrorMessageView";
+import { HeapTimelineChart } from "./HeapTimelineView";
+import { LayoutByteMaps } from "./LayoutView";
+import { LifecycleCountsTable } from "./LifecycleCounts";
+import { RemarksList } from "./OptimizationRemarks";
+import { ScheduleReport } from "./ScheduleOutputs";
 import { SubmissionEvaluation } from "./ProblemWorkspace";
-import { ExplanationMarkdown } from "./ExplanationMarkdown";
 
 export interface ProblemResultPanelProps {
   className?: string;
 
-  explanationMarkdown: string;
+  /** Explanation, already rendered on the server (see `ExplanationMarkdown`). */
+  explanation: React.ReactNode;
 
   /** Evaluation of the user's answer. */
   evaluation: SubmissionEvaluation;
@@ -36,6 +51,15 @@ export interface ProblemResultPanelProps {
 
   expectedResult: ProblemResult;
 
+  /** Question of "optimization" problems, answered by `expectedResult.optimized`. */
+  optimization?: OptimizationQuestion;
+
+  /** Name of the assembly listing, fetched only when the user opens it. */
+  asm?: string;
+
+  /** Candidate stdouts of "outputs" problems, checked against `expectedResult.schedules`. */
+  choices?: string[];
+
   /** Optional actions (parent handles navigation). */
   onRetry?: () => void;
   onNext?: () => void;
@@ -78,10 +102,13 @@ function actualOutputTitle(errorType: ErrorType) {
 
 export default function ProblemResultPanel({
   className,
-  explanationMarkdown,
+  explanation,
   evaluation,
   stdin,
   expectedResult,
+  optimization,
+  asm,
+  choices,
   onRetry,
   onNext,
 }: ProblemResultPanelProps) {
@@ -184,6 +211,130 @@ export default function ProblemResultPanel({
         </div>
       )}
 
+      {/* Traced copies and moves */}
+      {expectedResult.lifecycle && (
+        <div className="flex flex-col gap-3">
+          <_SectionHeader
+            icon={Copy}
+            title="Copies and moves"
+            subtitle="Special member calls of the gto::Traced objects over the whole run."
+          />
+          <div className="border-border bg-background/60 rounded-md border px-3 py-2">
+            <LifecycleCountsTable
+              expected={expectedResult.lifecycle}
+              guess={user?.lifecycle}
+            />
+          </div>
+        </div>
+      )}
+
+      {/* Heap allocations over the run */}
+      {expectedResult.heap && (
+        <div className="flex flex-col gap-3">
+          <_SectionHeader
+            icon={MemoryStick}
+            title="Heap timeline"
+            subtitle="Every operator new and delete of a real run, by line of output."
+          />
+          <div className="border-border bg-background/60 rounded-md border px-3 py-2">
+            <HeapTimelineChart
+              heap={expectedResult.heap}
+              stdout={expectedResult.stdout}
+            />
+          </div>
+        </div>
+      )}
+
+      {/* Record layouts */}
+      {expectedResult.layout && (
+        <div className="flex flex-col gap-3">
+          <_SectionHeader
+            icon={Ruler}
+            title="Memory layout"
+            subtitle="Offsets and sizes measured with offsetof and sizeof (x86-64, GCC)."
+          />
+          <div className="border-border bg-background/60 rounded-md border px-3 py-2">
+            <LayoutByteMaps
+              layouts={expectedResult.layout}
+              guess={user?.layout}
+            />
+          </div>
+        </div>
+      )}
+
+      {/* Explored thread schedules */}
+      {expectedResult.schedules && (
+        <div className="flex flex-col gap-3">
+          <_SectionHeader
+            icon={ListChecks}
+            title="Schedules explored"
+            subtitle="Outputs of the ThreadSanitizer build, run once per injected thread schedule."
+          />
+          <div className="border-border bg-background/60 rounded-md border px-3 py-2">
+            <ScheduleReport
+              schedules={expectedResult.schedules}
+              choices={choices}
+              selected={user?.outputs}
+            />
+          </div>
+        </div>
+      )}
+
+      {/* Compile timings of the variants */}
+      {expectedResult.compileTime && (
+        <div className="flex flex-col gap-3">
+          <_SectionHeader
+            icon={Hourglass}
+            title="Compile time"
+            subtitle="g++ -O2 -ftime-report per variant; instantiations from its class dump."
+          />
+          <div className="border-border bg-background/60 rounded-md border px-3 py-2">
+            <CompileTimeBars
+              report={expectedResult.compileTime}
+              guess={user?.fastestVariant}
+            />
+          </div>
+        </div>
+      )}
+
+      {/* Optimizer remarks */}
+      {expectedResult.remarks && (
+        <div className="flex flex-col gap-3">
+          <_SectionHeader
+            icon={Gauge}
+            title="Optimizer remarks"
+            subtitle={
+              optimization && typeof expectedResult.optimized === "boolean"
+                ? `${optimizationQuestionText(optimization)} ${optimizationAnswerText(
+                    optimization,
+                    expectedResult.optimized
+                  )}.`
+                : "What GCC reports at -O2 about vectorization and inlining."
+            }
+          />
+          <div
+            className="border-border bg-background/60 max-h-60 overflow-auto rounded-md border p-2"
+          >
+            <RemarksList
+              remarks={expectedResult.remarks}
+              highlightLine={optimization?.line}
+            />
+          </div>
+        </div>
+      )}
+
+      {/* Generated assembly */}
+      {asm && (
+        <div className="flex flex-col gap-3">
+          <_SectionHeader
+            icon={Cpu}
+            title="Generated assembly"
+            subtitle="What g++ makes of this code without and with optimizations."
+          />
+          <AssemblyView name={asm} />
+        </div>
+      )}
+
       {/* Actual stdin/stdout/error */}
       <div className="flex flex-col gap-3">
         <_SectionHeader
@@ -216,6 +367,7 @@ export default function ProblemResultPanel({
             <ErrorMessageView
               className="max-h-60"
               message={expectedResult.errorMessage}
+              sections={expectedResult.errorSections}
             />
           )}
         </div>
@@ -237,7 +389,7 @@ export default function ProblemResultPanel({
           icon={Info}
           title="Explanation"
         />
-        <ExplanationMarkdown markdown={explanationMarkdown} />
+        {explanation}
       </div>
 
       {/* Actions */}
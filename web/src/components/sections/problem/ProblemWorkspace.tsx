@@ -7,7 +7,15 @@ import { useRouter } from "next/navigation";
 import { CheckSquare, Code2, HelpCircle } from "lucide-react";
 
 import { cn } from "@/lib/utils";
-import type { ErrorType, ProblemData } from "@/lib/problems";
+import type { LayoutGuess } from "@/lib/layout";
+import type { LifecycleGuess } from "@/lib/lifecycle";
+import { PERF_MARKS, markPerf } from "@/lib/perf";
+import {
+  type CompactProblemsData,
+  type ErrorType,
+  type ProblemData,
+  decodeCompactProblems,
+} from "@/lib/problems";
 import { updateTrainingSessionTimers } from "@/lib/training/timers";
 import {
   getActiveTrainingSessionId,
@@ -31,6 +39,11 @@ type ProblemPhase = "answering" | "reviewing";
 export type UserSubmission = {
   errorType: ErrorType;
   stdout?: string; // only meaningful when errorType === "no-error"
+  lifecycle?: LifecycleGuess; // "lifecycle" answer mode
+  optimized?: boolean; // "optimization" answer mode
+  layout?: LayoutGuess; // "layout" answer mode
+  outputs?: string[]; // "outputs" answer mode
+  fastestVariant?: number; // "compileTime" answer mode
 };
 
 /** How the validator evaluated the submission (why success/failure). */
@@ -41,10 +54,31 @@ export type SubmissionEvaluation = {
   submission?: UserSubmission; // to show the user answer
 };
 
-export type ProblemsById = Record<string, ProblemData & { codeBlock: React.ReactNode }>;
+/** Code and explanation of a problem, rendered on the server (`CodeHighlight`, markdown). */
+export type RenderedBlocks = {
+  codeBlock: React.ReactNode;
+  explanationBlock: React.ReactNode;
+};
+
+type ProblemsById = Record<string, Omit<ProblemData, "explanation" | "code"> & RenderedBlocks>;
+
+/** Decoded on the client: the compact tuples are what the page payload carries. */
+function problemsWithBlocks(
+  problems: CompactProblemsData,
+  blocksById: Record<string, RenderedBlocks>
+): ProblemsById {
+  const map: ProblemsById = {};
+  for (const decoded of decodeCompactProblems(problems)) {
+    const { explanation: _explanation, code: _code, ...problem } = decoded;
+    map[problem.id] = { ...problem, ...blocksById[problem.id] };
+  }
+  return map;
+}
 
 export interface ProblemWorkspaceProps {
-  problemsById: ProblemsById;
+  /** Compact problems without code and explanations (see `withoutRenderedFields`). */
+  problems: CompactProblemsData;
+  blocksById: Record<string, RenderedBlocks>;
 
   /** Optional: parent can override what happens at end-of-session */
   onSessionComplete?: () => void;
@@ -79,11 +113,16 @@ function WorkspaceHeader({ phase }: { phase: ProblemPhase }) {
 }
 
 export default function ProblemWorkspace({
-  problemsById,
+  problems,
+  blocksById,
   className,
   onSessionComplete,
 }: ProblemWorkspaceProps) {
   const router = useRouter();
+  const problemsById = React.useMemo(
+    () => problemsWithBlocks(problems, blocksById),
+    [problems, blocksById]
+  );
   const [phase, setPhase] = React.useState<ProblemPhase>("answering");
   const [evaluation, setEvaluation] = React.useState<SubmissionEvaluation>({
     success: false,
@@ -103,6 +142,11 @@ export default function ProblemWorkspace({
     }
   }, [problem, router]);
 
+  React.useEffect(() => markPerf(PERF_MARKS.workspaceHydrated), []);
+  React.useLayoutEffect(() => {
+    if (problemId) markPerf(PERF_MARKS.problemRendered, problemId);
+  }, [problemId]);
+
   const revealMeta = phase === "reviewing";
 
   const { total, index, remaining } = getSessionCounts(session);
@@ -214,6 +258,7 @@ export default function ProblemWorkspace({
             concepts={problem?.concepts}
             difficulty={problem?.difficulty}
             revealMeta={revealMeta}
+            coverage={revealMeta ? problem?.result.coverage : undefined}
           >
             {problem?.codeBlock}
           </CodeBlockPanel>
@@ -230,13 +275,24 @@ export default function ProblemWorkspace({
               stdin={problem?.stdin}
               expectedStdout={problem?.result.stdout}
               expectedErrorType={problem?.result.errorType}
+              answerMode={problem?.answerMode}
+              expectedLifecycle={problem?.result.lifecycle}
+              optimization={problem?.optimization}
+              expectedOptimized={problem?.result.optimized}
+              expectedLayout={problem?.result.layout}
+              choices={problem?.choices}
+              expectedSchedules={problem?.result.schedules}
+              expectedCompileTime={problem?.result.compileTime}
               onSubmit={handleSubmit}
             />
           ) : (
             problem && (
               <ProblemResultPanel
                 className="h-full border-0 bg-transparent p-0"
-                explanationMarkdown={problem.explanation}
+                optimization={problem.optimization}
+                asm={problem.asm}
+                choices={problem.choices}
+                explanation={problem.explanationBlock}
                 evaluation={evaluation}
                 stdin={problem.stdin}
                 expectedResult={problem.result}
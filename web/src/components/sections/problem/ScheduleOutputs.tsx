@@ -0,0 +1,140 @@
+"use client";
+
+import { cn } from "@/lib/utils";
+import type { ScheduleExploration } from "@/lib/problems";
+import { inlineStdout, observedCount, unlistedOutputs } from "@/lib/schedules";
+
+import { Switch } from "@/components/ui/inputs";
+
+/** Answer side of the "outputs" mode: one switch per candidate stdout. */
+export function OutputChoicesFields({
+  choices,
+  selected,
+  mismatches,
+  onChange,
+}: {
+  choices: string[];
+  selected: string[];
+  /** Choices wrong at the last attempt (empty before any attempt). */
+  mismatches: string[];
+  onChange: (selected: string[]) => void;
+}) {
+  return (
+    <div className="grid gap-2 sm:grid-cols-2">
+      {choices.map((choice) => {
+        const checked = selected.includes(choice);
+        return (
+          <label
+            key={choice}
+            className={cn(
+              "bg-background/60 flex items-center justify-between gap-3 rounded-md border",
+              "px-3 py-2",
+              mismatches.includes(choice) && "border-red-500/50"
+            )}
+          >
+            <span className="text-foreground font-mono text-sm whitespace-pre">
+              {inlineStdout(choice)}
+            </span>
+            <Switch
+              checked={checked}
+              onCheckedChange={(next) =>
+                onChange(
+                  next
+                    ? choices.filter((c) => c === choice || selected.includes(c))
+                    : selected.filter((c) => c !== choice)
+                )
+              }
+              aria-label={`Possible output: ${inlineStdout(choice)}`}
+            />
+          </label>
+        );
+      })}
+    </div>
+  );
+}
+
+/**
+ * Review side: how often each output came out of the explored schedules, next to the player's
+ * picks, and the data races ThreadSanitizer reported.
+ */
+export function ScheduleReport({
+  schedules,
+  choices,
+  selected,
+}: {
+  schedules: ScheduleExploration;
+  choices?: string[];
+  selected?: string[];
+}) {
+  const rows = choices
+    ? [
+        ...choices.map((stdout) => ({ stdout, count: observedCount(stdout, schedules) })),
+        ...unlistedOutputs(choices, schedules),
+      ]
+    : schedules.outputs;
+  const completed = schedules.runs - schedules.failed;
+
+  return (
+    <div className="flex flex-col gap-3">
+      <table className="w-full text-sm">
+        <thead className="text-muted-foreground text-xs">
+          <tr>
+            <th className="py-1 text-left font-medium">Output</th>
+            <th className="py-1 text-right font-medium">Runs</th>
+            {selected && <th className="py-1 text-right font-medium">Your pick</th>}
+          </tr>
+        </thead>
+        <tbody className="font-mono">
+          {rows.map(({ stdout, count }) => {
+            const picked = selected?.includes(stdout) ?? false;
+            return (
+              <tr
+                key={stdout}
+                className="border-border border-t"
+              >
+                <td className="py-1 whitespace-pre">{inlineStdout(stdout)}</td>
+                <td className={cn("py-1 text-right", count === 0 && "text-muted-foreground")}>
+                  {count === 0 ? "never" : count}
+                </td>
+                {selected && (
+                  <td
+                    className={cn(
+                      "py-1 text-right font-sans",
+                      picked !== count > 0
+                        ? "text-red-600 dark:text-red-400"
+                        : "text-muted-foreground"
+                    )}
+                  >
+                    {picked ? "possible" : "—"}
+                  </td>
+                )}
+              </tr>
+            );
+          })}
+        </tbody>
+      </table>
+
+      <div className="text-muted-foreground text-xs">
+        {completed} of {schedules.runs} seeded runs completed
+        {schedules.failed > 0 && ` (${schedules.failed} crashed or timed out)`}.
+      </div>
+
+      {schedules.races.length > 0 && (
+        <ul className="flex flex-col gap-1 text-xs">
+          {schedules.races.map((race, i) => (
+            <li
+              key={i}
+              className="flex flex-wrap items-baseline gap-x-2 text-red-600 dark:text-red-400"
+            >
+              <span className="font-semibold">ThreadSanitizer: {race.kind}</span>
+              <span className="text-muted-foreground font-mono">
+                {race.line !== null ? `line ${race.line}` : "outside the problem"}
+                {race.function && ` in ${race.function}`}
+              </span>
+            </li>
+          ))}
+        </ul>
+      )}
+    </div>
+  );
+}
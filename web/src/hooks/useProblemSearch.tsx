@@ -0,0 +1,36 @@
+"use client";
+
+import * as React from "react";
+
+import { type SearchResult, searchProblems } from "@/lib/search";
+
+type SearchState = { query: string; result: SearchResult | null; error: string | null };
+
+/**
+ * Results of the problem search for `query` (run in the search worker).
+ * While a new query is running, the previous result is kept and `pending` is true.
+ */
+export function useProblemSearch(query: string) {
+  const trimmed = query.trim();
+  const [state, setState] = React.useState<SearchState>({ query: "", result: null, error: null });
+
+  React.useEffect(() => {
+    if (!trimmed) return;
+
+    let cancelled = false;
+    searchProblems(trimmed).then(
+      (result) => {
+        if (!cancelled && result) setState({ query: trimmed, result, error: null });
+      },
+      (error: Error) => {
+        if (!cancelled) setState({ query: trimmed, result: null, error: error.message });
+      }
+    );
+    return () => {
+      cancelled = true;
+    };
+  }, [trimmed]);
+
+  if (!trimmed) return { result: null, error: null, pending: false };
+  return { result: state.result, error: state.error, pending: state.query !== trimmed };
+}
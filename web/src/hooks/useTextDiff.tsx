@@ -0,0 +1,59 @@
+"use client";
+
+import * as React from "react";
+
+import { type DiffSpan, diffText, requestDiff, spansPrefix } from "@/lib/diff";
+
+/** Up to this many code points (both sides) the diff runs inline: cheaper than a round-trip. */
+const INLINE_DIFF_LIMIT = 1024;
+
+type AsyncDiff = { text: string; reference: string; spans: DiffSpan[] };
+
+/** Length in code points of the common prefix of `a` and `b`. */
+function commonPrefixLength(a: string, b: string): number {
+  let i = 0;
+  while (i < a.length && i < b.length && a.charCodeAt(i) === b.charCodeAt(i)) i++;
+  // Do not split a surrogate pair.
+  if (i > 0 && i < a.length && a.codePointAt(i - 1) !== a.charCodeAt(i - 1)) i--;
+  return Array.from(a.slice(0, i)).length;
+}
+
+/**
+ * Diff spans of `text` against `reference`, or `null` when there is nothing to compare
+ * (no reference). While a worker diff for the current inputs is still running, the last one
+ * completed against the same reference stands in for it, cut to the prefix the texts still
+ * share (the rest shows no diff): the colors do not flicker off on every keystroke, and never
+ * claim a match they have not checked. Stale worker requests are cancelled as soon as the
+ * inputs change.
+ */
+export function useTextDiff(text: string, reference: string | undefined): DiffSpan[] | null {
+  const channel = React.useId();
+  const inline = reference != null && text.length + reference.length <= INLINE_DIFF_LIMIT;
+
+  const inlineSpans = React.useMemo(
+    () => (inline ? diffText(text, reference as string) : null),
+    [inline, text, reference]
+  );
+
+  const [asyncDiff, setAsyncDiff] = React.useState<AsyncDiff | null>(null);
+
+  React.useEffect(() => {
+    if (reference == null || inline) return;
+
+    const request = requestDiff(text, reference, channel);
+    request.result.then((spans) => {
+      if (spans) setAsyncDiff({ text, reference, spans });
+    });
+    return request.cancel;
+  }, [channel, inline, text, reference]);
+
+  const asyncSpans = React.useMemo(() => {
+    if (!asyncDiff || asyncDiff.reference !== reference) return null;
+    if (asyncDiff.text === text) return asyncDiff.spans;
+    return spansPrefix(asyncDiff.spans, commonPrefixLength(asyncDiff.text, text));
+  }, [asyncDiff, text, reference]);
+
+  if (reference == null) return null;
+  if (inline) return inlineSpans;
+  return asyncSpans;
+}
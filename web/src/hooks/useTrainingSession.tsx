@@ -2,29 +2,20 @@
 
 import * as React from "react";
 
-import type { TrainingSession } from "@/lib/training/model";
-import { loadStore, subscribeStore } from "@/lib/training/storage";
+import { structuralEqual } from "@/lib/utils";
+import type { TrainingStore } from "@/lib/training/model";
 
-export function useTrainingSession(sessionId: string | null) {
-  const [session, setSession] = React.useState<TrainingSession | null>(() => {
-    if (!sessionId) return null;
-    return loadStore().sessionsById[sessionId as string] ?? null;
-  });
-
-  React.useEffect(() => {
-    if (!sessionId) {
-      setSession(null);
-      return;
-    }
-
-    const update = () => {
-      const s = loadStore().sessionsById[sessionId as string] ?? null;
-      setSession(s);
-    };
+import { useTrainingStore } from "@/hooks/useTrainingStore";
 
-    update();
-    return subscribeStore(update);
-  }, [sessionId]);
-
-  return session;
+/**
+ * Session `sessionId`, re-rendering only when that session changes.
+ * The workspace derives its initial problem from the session, so the browser store is read
+ * during hydration as well.
+ */
+export function useTrainingSession(sessionId: string | null) {
+  const selector = React.useCallback(
+    (store: TrainingStore) => (sessionId ? (store.sessionsById[sessionId] ?? null) : null),
+    [sessionId]
+  );
+  return useTrainingStore(selector, structuralEqual, { hydrateFromClient: true });
 }
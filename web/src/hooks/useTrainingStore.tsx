@@ -0,0 +1,63 @@
+"use client";
+
+import * as React from "react";
+
+import { structuralEqual } from "@/lib/utils";
+import type { TrainingSession, TrainingStore } from "@/lib/training/model";
+import { SERVER_STORE, loadStore, subscribeStore } from "@/lib/training/storage";
+
+type Selector<T> = (store: TrainingStore) => T;
+type Equality<T> = (a: T, b: T) => boolean;
+
+type StoreSelectionOptions = {
+  /**
+   * Read the browser store during hydration too, instead of the empty server store. Only for
+   * components that are not server-rendered with store data (they derive their initial state
+   * from it); others would get a hydration mismatch.
+   */
+  hydrateFromClient?: boolean;
+};
+
+/**
+ * `useSyncExternalStore` over the shared store snapshot, narrowed by `selector`.
+ * The selection is recomputed only when the snapshot changes, and the previous value is kept
+ * while it is `isEqual` to the new one, so a component only re-renders when its slice changes.
+ * `selector` should be stable (module-level or `useCallback`).
+ */
+export function useTrainingStore<T>(
+  selector: Selector<T>,
+  isEqual: Equality<T> = structuralEqual,
+  { hydrateFromClient = false }: StoreSelectionOptions = {}
+): T {
+  const [getSelection, getServerSelection] = React.useMemo(() => {
+    let memo: { store: TrainingStore; selected: T } | null = null;
+
+    const select = (store: TrainingStore) => {
+      if (memo && memo.store === store) return memo.selected;
+      const selected = selector(store);
+      const kept = memo && isEqual(memo.selected, selected) ? memo.selected : selected;
+      memo = { store, selected: kept };
+      return kept;
+    };
+
+    const getClient = () => select(loadStore());
+    return [getClient, hydrateFromClient ? getClient : () => select(SERVER_STORE)];
+  }, [selector, isEqual, hydrateFromClient]);
+
+  return React.useSyncExternalStore(subscribeStore, getSelection, getServerSelection);
+}
+
+const selectActiveSessionId: Selector<string | null> = (store) => store.activeSessionId;
+
+export function useActiveSessionId(): string | null {
+  return useTrainingStore(selectActiveSessionId, Object.is);
+}
+
+const selectLocalSessions: Selector<TrainingSession[]> = (store) =>
+  Object.values(store.sessionsById).sort((a, b) => b.meta.lastOpenedAt - a.meta.lastOpenedAt);
+
+/** Sessions kept in localStorage, most recently opened first (see `listTrainingSessions`). */
+export function useLocalSessions(): TrainingSession[] {
+  return useTrainingStore(selectLocalSessions);
+}
+
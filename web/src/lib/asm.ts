@@ -0,0 +1,34 @@
+/** Optimization levels of the listings, in display order (see `ASM_LEVELS` in `run_all.py`). */
+export const ASM_LEVELS = ["-O0", "-O2"] as const;
+
+export type AsmLevel = (typeof ASM_LEVELS)[number];
+
+/** Instructions of one source line (null: inlined library code), newline separated. */
+export type AsmBlock = [line: number | null, text: string];
+
+export type AsmFunction = {
+  name: string;
+  blocks: AsmBlock[];
+};
+
+/** Functions of the problem's source, in source order, at each level. */
+export type AsmListing = Record<AsmLevel, AsmFunction[]>;
+
+const listings = new Map<string, Promise<AsmListing>>();
+
+/**
+ * Assembly listing `name` (`ProblemData.asm`), from `public/generated/asm/`. Listings are only
+ * fetched when the review panel shows them; a failed fetch is forgotten so it can be retried.
+ */
+export function loadAsmListing(name: string): Promise<AsmListing> {
+  let listing = listings.get(name);
+  if (!listing) {
+    listing = fetch(`/generated/asm/${name}.json`).then(async (response) => {
+      if (!response.ok) throw new Error(`Cannot load the assembly listing (${response.status})`);
+      return (await response.json()) as AsmListing;
+    });
+    listing.catch(() => listings.delete(name));
+    listings.set(name, listing);
+  }
+  return listing;
+}
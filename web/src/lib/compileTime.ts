@@ -0,0 +1,27 @@
+import type { CompileTimeVariant } from "./problems";
+
+/** Phases timed by `-ftime-report` besides the total, in display order. */
+export const COMPILE_PHASE_LABELS = {
+  frontend: "Frontend",
+  instantiation: "Template instantiation",
+  constexpr: "Constant evaluation",
+} as const satisfies Partial<Record<keyof CompileTimeVariant, string>>;
+
+export type CompilePhase = keyof typeof COMPILE_PHASE_LABELS;
+
+export function variantName(index: number, label: string): string {
+  return `Variant ${index}: ${label}`;
+}
+
+export function formatCompileSeconds(seconds: number): string {
+  return seconds < 1 ? `${Math.round(seconds * 1000)} ms` : `${seconds.toFixed(2)} s`;
+}
+
+export function formatMegabytes(bytes: number): string {
+  return `${(bytes / (1 << 20)).toFixed(1)} MB`;
+}
+
+/** How many times slower than the fastest variant (1 for the fastest itself). */
+export function slowdown(variant: CompileTimeVariant, fastest: CompileTimeVariant): number {
+  return fastest.seconds > 0 ? variant.seconds / fastest.seconds : 1;
+}
@@ -0,0 +1,23 @@
+import type { LineCountRun } from "./problems";
+
+/** Execution count of every line that generates code, by 1-based line number. */
+export function lineCounts(runs: LineCountRun[]): Map<number, number> {
+  const counts = new Map<number, number>();
+  for (const { line, length, count } of runs) {
+    for (let offset = 0; offset < length; offset++) counts.set(line + offset, count);
+  }
+  return counts;
+}
+
+/** Heat of a count in [0, 1], on a log scale up to the hottest line (0 for lines never run). */
+export function lineHeat(count: number, hottest: number): number {
+  if (count <= 0 || hottest <= 0) return 0;
+  return Math.log1p(count) / Math.log1p(hottest);
+}
+
+/** Short count for the gutter: 7, 950, 1.2k, 34k, 5.6M. */
+export function formatLineCount(count: number): string {
+  if (count < 1000) return String(count);
+  const [value, unit] = count < 1e6 ? [count / 1e3, "k"] : [count / 1e6, "M"];
+  return `${value < 10 ? value.toFixed(1) : Math.round(value)}${unit}`;
+}
@@ -0,0 +1,68 @@
+import type { DiagnosticSection, ErrorMessage } from "@/lib/problems";
+
+/**
+ * Compiler diagnostics grouped for display: each error with the context printed before it
+ * (`backtrace`) and the notes printed after it. Lines are `ErrorMessage` parts split at newlines.
+ */
+export type Diagnostic = {
+  kind: "error" | "text";
+  backtrace: ErrorMessage[];
+  lines: ErrorMessage[];
+  notes: ErrorMessage[];
+};
+
+/** Parts of `message`, one array per line (a trailing newline does not start a new line). */
+export function splitMessageLines(message: ErrorMessage): ErrorMessage[] {
+  const lines: ErrorMessage[] = [[]];
+  for (const part of message) {
+    const pieces = part.text.split("\n");
+    pieces.forEach((text, i) => {
+      if (i > 0) lines.push([]);
+      if (text) lines[lines.length - 1].push({ ...part, text });
+    });
+  }
+  if (lines.length > 1 && lines[lines.length - 1].length === 0) lines.pop();
+  return lines;
+}
+
+/**
+ * Group the lines of `message` by its `sections` (from the generator). Without sections, or if
+ * they do not match the message, everything is one block of text.
+ */
+export function groupDiagnostics(
+  message: ErrorMessage,
+  sections: DiagnosticSection[] | undefined
+): Diagnostic[] {
+  const lines = splitMessageLines(message);
+  const total = sections?.reduce((sum, s) => sum + s.lines, 0);
+  if (!sections || total !== lines.length) {
+    return [{ kind: "text", backtrace: [], lines, notes: [] }];
+  }
+
+  const diagnostics: Diagnostic[] = [];
+  let backtrace: ErrorMessage[] = [];
+  let start = 0;
+
+  for (const section of sections) {
+    const sectionLines = lines.slice(start, start + section.lines);
+    start += section.lines;
+
+    const last = diagnostics[diagnostics.length - 1];
+    if (section.kind === "backtrace") {
+      backtrace.push(...sectionLines);
+    } else if (section.kind === "note" && last?.kind === "error") {
+      // Notes come with their own context (e.g. "In file included from" for candidates).
+      last.notes.push(...backtrace, ...sectionLines);
+      backtrace = [];
+    } else {
+      const kind = section.kind === "error" ? "error" : "text";
+      diagnostics.push({ kind, backtrace, lines: sectionLines, notes: [] });
+      backtrace = [];
+    }
+  }
+
+  if (backtrace.length > 0) {
+    diagnostics.push({ kind: "text", backtrace: [], lines: backtrace, notes: [] });
+  }
+  return diagnostics;
+}
@@ -0,0 +1,58 @@
+import type { DiffWorkerRequest, DiffWorkerResponse } from "./diff.worker";
+import { type DiffSpan, diffText } from "./myers";
+
+type PendingRequest = (spans: DiffSpan[] | null) => void;
+
+let worker: Worker | null = null;
+let nextRequestId = 1;
+const pending = new Map<number, PendingRequest>();
+
+function getDiffWorker(): Worker | null {
+  if (typeof window === "undefined" || typeof Worker === "undefined") return null;
+
+  if (!worker) {
+    worker = new Worker(new URL("./diff.worker.ts", import.meta.url));
+    worker.addEventListener("message", (event: MessageEvent<DiffWorkerResponse>) => {
+      const { id, spans } = event.data;
+      const resolve = pending.get(id);
+      pending.delete(id);
+      resolve?.(spans);
+    });
+  }
+  return worker;
+}
+
+export type DiffRequest = {
+  /** Resolves with the spans, or `null` if the request was superseded or cancelled. */
+  result: Promise<DiffSpan[] | null>;
+  cancel: () => void;
+};
+
+/**
+ * Diff `text` against `reference` off the main thread.
+ * A new request on the same `channel` supersedes the previous one.
+ * Falls back to a synchronous diff where workers are unavailable (SSR, tests).
+ */
+export function requestDiff(text: string, reference: string, channel: string): DiffRequest {
+  const w = getDiffWorker();
+  if (!w) {
+    return { result: Promise.resolve(diffText(text, reference)), cancel: () => {} };
+  }
+
+  const id = nextRequestId++;
+  const result = new Promise<DiffSpan[] | null>((resolve) => pending.set(id, resolve));
+
+  const message: DiffWorkerRequest = { type: "diff", id, channel, text, reference };
+  w.postMessage(message);
+
+  return {
+    result,
+    cancel: () => {
+      const resolve = pending.get(id);
+      if (!resolve) return;
+      pending.delete(id);
+      resolve(null);
+      w.postMessage({ type: "cancel", id } satisfies DiffWorkerRequest);
+    },
+  };
+}
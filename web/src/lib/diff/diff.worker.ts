@@ -0,0 +1,55 @@
+import { type DiffSpan, diffText } from "./myers";
+
+/**
+ * Diff worker.
+ * Requests are keyed by `channel` (one per component): only the latest request of a channel is
+ * computed, older ones still waiting in the queue are answered with `spans: null`.
+ */
+
+export type DiffWorkerRequest =
+  | { type: "diff"; id: number; channel: string; text: string; reference: string }
+  | { type: "cancel"; id: number };
+
+export type DiffWorkerResponse = { id: number; spans: DiffSpan[] | null };
+
+/** Refinement budget per request; past it the diff degrades to coarser (still valid) spans. */
+const DIFF_TIMEOUT_MS = 200;
+
+const latestByChannel = new Map<string, Extract<DiffWorkerRequest, { type: "diff" }>>();
+let drainScheduled = false;
+
+function reply(response: DiffWorkerResponse) {
+  self.postMessage(response);
+}
+
+function drain() {
+  drainScheduled = false;
+  const jobs = Array.from(latestByChannel.values());
+  latestByChannel.clear();
+
+  for (const job of jobs) {
+    const spans = diffText(job.text, job.reference, { timeoutMs: DIFF_TIMEOUT_MS });
+    reply({ id: job.id, spans });
+  }
+}
+
+self.addEventListener("message", (event: MessageEvent<DiffWorkerRequest>) => {
+  const request = event.data;
+
+  if (request.type === "cancel") {
+    for (const [channel, job] of latestByChannel) {
+      if (job.id === request.id) latestByChannel.delete(channel);
+    }
+    return;
+  }
+
+  const stale = latestByChannel.get(request.channel);
+  if (stale) reply({ id: stale.id, spans: null });
+  latestByChannel.set(request.channel, request);
+
+  // Let queued messages arrive before computing, so bursts collapse into one diff.
+  if (!drainScheduled) {
+    drainScheduled = true;
+    setTimeout(drain, 0);
+  }
+});
@@ -0,0 +1,2 @@
+export * from "./myers";
+export * from "./client";
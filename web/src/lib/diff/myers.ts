@@ -0,0 +1,344 @@
+/**
+ * Linear-space Myers diff (middle-snake bisection), producing run-length spans.
+ *
+ * Spans describe how to turn `reference` into `text`:
+ * - "equal": present in both
+ * - "insert": only in `text` (extra characters)
+ * - "delete": only in `reference` (missing characters)
+ *
+ * Lengths are counted in code points, so they line up with `Array.from(text)`.
+ */
+
+export type DiffKind = "equal" | "insert" | "delete";
+
+export type DiffSpan = {
+  kind: DiffKind;
+  length: number;
+};
+
+export type DiffOptions = {
+  /**
+   * Above this many code points (both sides), lines are aligned first and only the changed
+   * blocks are diffed character by character.
+   */
+  lineModeThreshold?: number;
+
+  /**
+   * Give up refining after this many milliseconds: the remaining ranges are reported as a
+   * plain delete + insert. The result stays valid, only less minimal.
+   */
+  timeoutMs?: number;
+};
+
+const DEFAULT_LINE_MODE_THRESHOLD = 4096;
+
+type Sequence = ArrayLike<number>;
+
+class SpanBuilder {
+  readonly spans: DiffSpan[] = [];
+
+  push(kind: DiffKind, length: number) {
+    if (length <= 0) return;
+    const last = this.spans[this.spans.length - 1];
+    if (last && last.kind === kind) {
+      last.length += length;
+    } else {
+      this.spans.push({ kind, length });
+    }
+  }
+}
+
+/** Diff two integer sequences. `deadline` is a `performance.now()` timestamp (or Infinity). */
+function diffRange(
+  a: Sequence,
+  aStart: number,
+  aEnd: number,
+  b: Sequence,
+  bStart: number,
+  bEnd: number,
+  deadline: number,
+  out: SpanBuilder
+) {
+  // Common prefix
+  let prefix = 0;
+  while (
+    aStart + prefix < aEnd &&
+    bStart + prefix < bEnd &&
+    a[aStart + prefix] === b[bStart + prefix]
+  ) {
+    prefix++;
+  }
+  out.push("equal", prefix);
+  aStart += prefix;
+  bStart += prefix;
+
+  // Common suffix (emitted after the middle part)
+  let suffix = 0;
+  while (
+    aEnd - suffix > aStart &&
+    bEnd - suffix > bStart &&
+    a[aEnd - suffix - 1] === b[bEnd - suffix - 1]
+  ) {
+    suffix++;
+  }
+  aEnd -= suffix;
+  bEnd -= suffix;
+
+  if (aStart === aEnd) {
+    out.push("insert", bEnd - bStart);
+  } else if (bStart === bEnd) {
+    out.push("delete", aEnd - aStart);
+  } else {
+    bisect(a, aStart, aEnd, b, bStart, bEnd, deadline, out);
+  }
+
+  out.push("equal", suffix);
+}
+
+/**
+ * Find the middle snake of the shortest edit script, then recurse on both halves.
+ * Forward and reverse searches run on diagonals `k = x - y` with O(N + M) memory.
+ */
+function bisect(
+  a: Sequence,
+  aStart: number,
+  aEnd: number,
+  b: Sequence,
+  bStart: number,
+  bEnd: number,
+  deadline: number,
+  out: SpanBuilder
+) {
+  const n = aEnd - aStart;
+  const m = bEnd - bStart;
+  const maxD = Math.ceil((n + m) / 2);
+  const vOffset = maxD;
+  const vLength = 2 * maxD + 2;
+
+  // Furthest x reached on each diagonal, forward (v1) and backward (v2, measured from the end).
+  const v1 = new Int32Array(vLength).fill(-1);
+  const v2 = new Int32Array(vLength).fill(-1);
+  v1[vOffset + 1] = 0;
+  v2[vOffset + 1] = 0;
+
+  const delta = n - m;
+  // If the total length is odd, the forward path collides with the reverse path.
+  const front = delta % 2 !== 0;
+
+  // Diagonals that ran off the grid are trimmed from the search.
+  let k1start = 0;
+  let k1end = 0;
+  let k2start = 0;
+  let k2end = 0;
+
+  for (let d = 0; d < maxD; d++) {
+    if (performance.now() > deadline) break;
+
+    for (let k1 = -d + k1start; k1 <= d - k1end; k1 += 2) {
+      const k1Offset = vOffset + k1;
+      let x1 =
+        k1 === -d || (k1 !== d && v1[k1Offset - 1] < v1[k1Offset + 1])
+          ? v1[k1Offset + 1]
+          : v1[k1Offset - 1] + 1;
+      let y1 = x1 - k1;
+      while (x1 < n && y1 < m && a[aStart + x1] === b[bStart + y1]) {
+        x1++;
+        y1++;
+      }
+      v1[k1Offset] = x1;
+
+      if (x1 > n) {
+        k1end += 2;
+      } else if (y1 > m) {
+        k1start += 2;
+      } else if (front) {
+        const k2Offset = vOffset + delta - k1;
+        if (k2Offset >= 0 && k2Offset < vLength && v2[k2Offset] !== -1) {
+          const x2 = n - v2[k2Offset];
+          if (x1 >= x2) {
+            split(a, aStart, aEnd, b, bStart, bEnd, x1, y1, deadline, out);
+            return;
+          }
+        }
+      }
+    }
+
+    for (let k2 = -d + k2start; k2 <= d - k2end; k2 += 2) {
+      const k2Offset = vOffset + k2;
+      let x2 =
+        k2 === -d || (k2 !== d && v2[k2Offset - 1] < v2[k2Offset + 1])
+          ? v2[k2Offset + 1]
+          : v2[k2Offset - 1] + 1;
+      let y2 = x2 - k2;
+      while (x2 < n && y2 < m && a[aEnd - x2 - 1] === b[bEnd - y2 - 1]) {
+        x2++;
+        y2++;
+      }
+      v2[k2Offset] = x2;
+
+      if (x2 > n) {
+        k2end += 2;
+      } else if (y2 > m) {
+        k2start += 2;
+      } else if (!front) {
+        const k1Offset = vOffset + delta - k2;
+        if (k1Offset >= 0 && k1Offset < vLength && v1[k1Offset] !== -1) {
+          const x1 = v1[k1Offset];
+          const y1 = vOffset + x1 - k1Offset;
+          if (x1 >= n - x2) {
+            split(a, aStart, aEnd, b, bStart, bEnd, x1, y1, deadline, out);
+            return;
+          }
+        }
+      }
+    }
+  }
+
+  // Nothing in common (or out of time).
+  out.push("delete", n);
+  out.push("insert", m);
+}
+
+function split(
+  a: Sequence,
+  aStart: number,
+  aEnd: number,
+  b: Sequence,
+  bStart: number,
+  bEnd: number,
+  x: number,
+  y: number,
+  deadline: number,
+  out: SpanBuilder
+) {
+  diffRange(a, aStart, aStart + x, b, bStart, bStart + y, deadline, out);
+  diffRange(a, aStart + x, aEnd, b, bStart + y, bEnd, deadline, out);
+}
+
+/** Shortest edit script between two integer sequences. */
+export function diffSequences(a: Sequence, b: Sequence, options: DiffOptions = {}): DiffSpan[] {
+  const deadline = options.timeoutMs != null ? performance.now() + options.timeoutMs : Infinity;
+  const out = new SpanBuilder();
+  diffRange(a, 0, a.length, b, 0, b.length, deadline, out);
+  return out.spans;
+}
+
+function toCodePoints(chars: string[]): Int32Array {
+  const out = new Int32Array(chars.length);
+  for (let i = 0; i < chars.length; i++) {
+    out[i as number] = chars[i as number].codePointAt(0) ?? 0;
+  }
+  return out;
+}
+
+/** Split into lines, keeping the trailing "\n" on each line (as code point arrays). */
+function splitLines(chars: string[]): string[][] {
+  const lines: string[][] = [];
+  let current: string[] = [];
+  for (const c of chars) {
+    current.push(c);
+    if (c === "\n") {
+      lines.push(current);
+      current = [];
+    }
+  }
+  if (current.length > 0) lines.push(current);
+  return lines;
+}
+
+/**
+ * Line pass first, then character refinement of each changed block.
+ * Keeps long outputs with a few edits close to linear time.
+ */
+function diffByLines(reference: string[], text: string[], deadline: number, out: SpanBuilder) {
+  const refLines = splitLines(reference);
+  const textLines = splitLines(text);
+
+  // Intern lines so they compare as integers.
+  const ids = new Map<string, number>();
+  const intern = (line: string[]) => {
+    const key = line.join("");
+    let id = ids.get(key);
+    if (id === undefined) {
+      id = ids.size;
+      ids.set(key, id);
+    }
+    return id;
+  };
+  const a = Int32Array.from(refLines, intern);
+  const b = Int32Array.from(textLines, intern);
+
+  const lineOut = new SpanBuilder();
+  diffRange(a, 0, a.length, b, 0, b.length, deadline, lineOut);
+
+  let ai = 0;
+  let bi = 0;
+  const spans = lineOut.spans;
+  for (let i = 0; i < spans.length; i++) {
+    const span = spans[i as number];
+
+    if (span.kind === "equal") {
+      for (let j = 0; j < span.length; j++) out.push("equal", refLines[ai + j].length);
+      ai += span.length;
+      bi += span.length;
+      continue;
+    }
+
+    // Collect a whole changed block (deletes and inserts, in any order).
+    let deleted = 0;
+    let inserted = 0;
+    while (i < spans.length && spans[i as number].kind !== "equal") {
+      if (spans[i as number].kind === "delete") deleted += spans[i as number].length;
+      else inserted += spans[i as number].length;
+      i++;
+    }
+    i--;
+
+    const blockA = toCodePoints(refLines.slice(ai, ai + deleted).flat());
+    const blockB = toCodePoints(textLines.slice(bi, bi + inserted).flat());
+    diffRange(blockA, 0, blockA.length, blockB, 0, blockB.length, deadline, out);
+
+    ai += deleted;
+    bi += inserted;
+  }
+}
+
+/** Character diff of `text` against `reference` (code point based). */
+export function diffText(text: string, reference: string, options: DiffOptions = {}): DiffSpan[] {
+  const deadline = options.timeoutMs != null ? performance.now() + options.timeoutMs : Infinity;
+  const threshold = options.lineModeThreshold ?? DEFAULT_LINE_MODE_THRESHOLD;
+
+  const refChars = Array.from(reference);
+  const textChars = Array.from(text);
+  const out = new SpanBuilder();
+
+  if (refChars.length + textChars.length > threshold) {
+    diffByLines(refChars, textChars, deadline, out);
+  } else {
+    const a = toCodePoints(refChars);
+    const b = toCodePoints(textChars);
+    diffRange(a, 0, a.length, b, 0, b.length, deadline, out);
+  }
+
+  return out.spans;
+}
+
+/**
+ * The part of `spans` covering the first `length` code points of their text: what still holds
+ * for a text that only shares that prefix with it. A deletion at the cut is left out.
+ */
+export function spansPrefix(spans: DiffSpan[], length: number): DiffSpan[] {
+  const prefix: DiffSpan[] = [];
+  let covered = 0;
+  for (const span of spans) {
+    if (covered >= length) break;
+    if (span.kind === "delete") {
+      prefix.push(span);
+      continue;
+    }
+    const taken = Math.min(span.length, length - covered);
+    prefix.push(taken === span.length ? span : { kind: span.kind, length: taken });
+    covered += taken;
+  }
+  return prefix;
+}
@@ -0,0 +1,147 @@
+import type { ProblemDifficulty } from "@/lib/problems";
+
+/**
+ * Facet index emitted by `problems/run_all.py` (`web/data/problems.facets.json`).
+ *
+ * Problems are identified by their position in `problemIds`. Each concept and difficulty maps
+ * to the set of positions that have it, encoded either as a sorted position list (sparse facets)
+ * or as a base64 bitset of little-endian uint32 words (dense facets).
+ */
+export type EncodedFacet = number[] | string;
+
+export type FacetIndexData = {
+  version: 1;
+  size: number;
+  problemIds: string[];
+  concepts: string[]; // interned, in order of first appearance
+  conceptCounts: number[];
+  byConcept: EncodedFacet[]; // aligned with `concepts`
+  difficultyCounts: Record<string, number>;
+  byDifficulty: Record<string, EncodedFacet>;
+};
+
+export type FacetFilter = {
+  difficultyMin: number;
+  difficultyMax: number;
+  concepts: string[]; // any of them; empty = no filter
+};
+
+export type FacetIndex = {
+  size: number;
+  words: number; // uint32 words per bitset
+  problemIds: string[];
+  concepts: string[];
+  conceptCounts: number[];
+  /** Difficulty of each problem, by position. */
+  difficultyOf: Uint8Array;
+  byDifficulty: Map<ProblemDifficulty, Uint32Array>;
+  conceptIds: Map<string, number>;
+  /** Concept bitset by concept id, decoded on first use. */
+  conceptBits: (conceptId: number) => Uint32Array;
+};
+
+function decodeFacet(facet: EncodedFacet, words: number): Uint32Array {
+  const bits = new Uint32Array(words);
+
+  if (typeof facet !== "string") {
+    for (const pos of facet) bits[pos >>> 5] |= 1 << (pos & 31);
+    return bits;
+  }
+
+  const bytes = Uint8Array.from(atob(facet), (c) => c.charCodeAt(0));
+  const view = new DataView(bytes.buffer);
+  for (let i = 0; i < words && i * 4 + 3 < bytes.length; i++) {
+    bits[i as number] = view.getUint32(i * 4, true);
+  }
+  return bits;
+}
+
+export function decodeFacetIndex(data: FacetIndexData): FacetIndex {
+  const words = (data.size + 31) >>> 5;
+
+  const difficultyOf = new Uint8Array(data.size);
+  const byDifficulty = new Map<ProblemDifficulty, Uint32Array>();
+  for (const [key, facet] of Object.entries(data.byDifficulty)) {
+    const difficulty = Number(key) as ProblemDifficulty;
+    const bits = decodeFacet(facet, words);
+    byDifficulty.set(difficulty, bits);
+    forEachPosition(bits, (pos) => (difficultyOf[pos as number] = difficulty));
+  }
+
+  const conceptIds = new Map(data.concepts.map((concept, id) => [concept, id]));
+  const conceptCache = new Map<number, Uint32Array>();
+  const conceptBits = (conceptId: number) => {
+    let bits = conceptCache.get(conceptId);
+    if (!bits) {
+      bits = decodeFacet(data.byConcept[conceptId as number], words);
+      conceptCache.set(conceptId, bits);
+    }
+    return bits;
+  };
+
+  return {
+    size: data.size,
+    words,
+    problemIds: data.problemIds,
+    concepts: data.concepts,
+    conceptCounts: data.conceptCounts,
+    difficultyOf,
+    byDifficulty,
+    conceptIds,
+    conceptBits,
+  };
+}
+
+/** Problems matching the filter: (any difficulty in range) AND (any selected concept). */
+export function matchFacets(index: FacetIndex, filter: FacetFilter): Uint32Array {
+  const result = new Uint32Array(index.words);
+
+  for (const [difficulty, bits] of index.byDifficulty) {
+    if (difficulty < filter.difficultyMin || difficulty > filter.difficultyMax) continue;
+    for (let i = 0; i < index.words; i++) result[i as number] |= bits[i as number];
+  }
+
+  if (filter.concepts.length === 0) return result;
+
+  const concepts = new Uint32Array(index.words);
+  for (const concept of filter.concepts) {
+    const id = index.conceptIds.get(concept);
+    if (id === undefined) continue;
+    const bits = index.conceptBits(id);
+    for (let i = 0; i < index.words; i++) concepts[i as number] |= bits[i as number];
+  }
+  for (let i = 0; i < index.words; i++) result[i as number] &= concepts[i as number];
+
+  return result;
+}
+
+function popcount32(x: number) {
+  x -= (x >>> 1) & 0x55555555;
+  x = (x & 0x33333333) + ((x >>> 2) & 0x33333333);
+  x = (x + (x >>> 4)) & 0x0f0f0f0f;
+  return Math.imul(x, 0x01010101) >>> 24;
+}
+
+export function countBits(bits: Uint32Array) {
+  let count = 0;
+  for (let i = 0; i < bits.length; i++) count += popcount32(bits[i as number]);
+  return count;
+}
+
+/** Call `fn` with every set position, in increasing order. */
+export function forEachPosition(bits: Uint32Array, fn: (pos: number) => void) {
+  for (let i = 0; i < bits.length; i++) {
+    let word = bits[i as number];
+    while (word !== 0) {
+      const low = word & -word;
+      fn(i * 32 + 31 - Math.clz32(low));
+      word ^= low;
+    }
+  }
+}
+
+export function bitsToPositions(bits: Uint32Array): number[] {
+  const positions: number[] = [];
+  forEachPosition(bits, (pos) => positions.push(pos));
+  return positions;
+}
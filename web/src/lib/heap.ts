@@ -0,0 +1,67 @@
+import type { HeapEvent } from "./problems";
+
+/** An event with the bytes still allocated right after it. */
+export type PlacedHeapEvent = HeapEvent & { live: number };
+
+/**
+ * The events that happened before line `line` + 1 of the output was complete, with the text of
+ * that line (null past the end of the output: at exit, or when the output is unknown).
+ */
+export type HeapTimelineRow = {
+  line: number;
+  text: string | null;
+  events: PlacedHeapEvent[];
+};
+
+/** Rows of the timeline in output order; lines without heap calls are left out. */
+export function heapTimelineRows(events: HeapEvent[], stdout?: string): HeapTimelineRow[] {
+  const lines = stdout ? stdout.split("\n") : [];
+  if (lines.at(-1) === "") lines.pop();
+
+  const rows: HeapTimelineRow[] = [];
+  let live = 0;
+  for (const event of events) {
+    live += event.op === "alloc" ? event.bytes : -event.bytes;
+    let row = rows.at(-1);
+    if (!row || row.line !== event.line) {
+      row = { line: event.line, text: lines[event.line] ?? null, events: [] };
+      rows.push(row);
+    }
+    row.events.push({ ...event, live });
+  }
+  return rows;
+}
+
+/** Where a row is in the output, by lines written when the text of the line is unknown. */
+export function heapTimelineRowTitle({ line, text }: HeapTimelineRow): string {
+  if (text !== null) return `Before line ${line + 1} of the output`;
+  if (line === 0) return "Before any output";
+  return `After ${line} line${line === 1 ? "" : "s"} of output`;
+}
+
+/** Highest number of bytes allocated at once. */
+export function peakLiveBytes(rows: HeapTimelineRow[]): number {
+  return Math.max(0, ...rows.flatMap((row) => row.events.map((event) => event.live)));
+}
+
+/** Blocks allocated and never released, e.g. still owned by a leaked pointer at exit. */
+export function unreleasedBlocks(events: HeapEvent[]): number {
+  const live = new Set<number>();
+  for (const { op, block } of events) {
+    if (op === "alloc") live.add(block);
+    else live.delete(block);
+  }
+  return live.size;
+}
+
+/** 12 B, 4.0 KiB, 1.5 MiB. */
+export function formatBytes(bytes: number): string {
+  if (bytes < 1024) return `${bytes} B`;
+  const [value, unit] = bytes < 1 << 20 ? [bytes / 1024, "KiB"] : [bytes / (1 << 20), "MiB"];
+  return `${value.toFixed(1)} ${unit}`;
+}
+
+/** new #2 (8 B), delete #1 (4 B). */
+export function heapEventLabel(event: HeapEvent): string {
+  return `${event.op === "alloc" ? "new" : "delete"} #${event.block} (${formatBytes(event.bytes)})`;
+}
@@ -0,0 +1,39 @@
+import type { RecordLayout } from "./problems";
+
+/** Cache line size of the x86-64 machines the layouts are measured on. */
+export const CACHE_LINE_BYTES = 64;
+
+/** Guessed `sizeof` of each struct, by name. */
+export type LayoutGuess = Record<string, number>;
+
+export function emptyLayoutGuess(layouts: RecordLayout[]): LayoutGuess {
+  return Object.fromEntries(layouts.map((layout) => [layout.name, 0]));
+}
+
+/** Structs whose guessed size is wrong, in `layouts` order. */
+export function layoutMismatches(guess: LayoutGuess, layouts: RecordLayout[]): string[] {
+  return layouts.filter((layout) => (guess[layout.name] ?? 0) !== layout.size).map((l) => l.name);
+}
+
+/**
+ * Owner of every byte of the struct: the index of the member in `layout.members`, or -1 for
+ * padding (bytes no listed member covers).
+ */
+export function layoutByteOwners(layout: RecordLayout): number[] {
+  const owners = new Array<number>(layout.size).fill(-1);
+  layout.members.forEach((member, index) => {
+    for (let byte = member.offset; byte < member.offset + member.size; byte++) {
+      if (byte < owners.length) owners[byte] = index;
+    }
+  });
+  return owners;
+}
+
+export function paddingBytes(layout: RecordLayout): number {
+  return layoutByteOwners(layout).filter((owner) => owner === -1).length;
+}
+
+/** Elements of an array of the struct per cache line (fractional when they straddle lines). */
+export function elementsPerCacheLine(layout: RecordLayout): number {
+  return CACHE_LINE_BYTES / layout.size;
+}
@@ -0,0 +1,33 @@
+import type { LifecycleCounter, LifecycleCounts } from "./problems";
+
+export const LIFECYCLE_COUNTER_LABELS: Record<LifecycleCounter, string> = {
+  constructed: "Constructions from a value",
+  defaultConstructed: "Default constructions",
+  copyConstructed: "Copy constructions",
+  moveConstructed: "Move constructions",
+  copyAssigned: "Copy assignments",
+  moveAssigned: "Move assignments",
+  destroyed: "Destructions",
+};
+
+/** Counters the player guesses in the "lifecycle" answer mode; all of them are shown at review. */
+export const GUESSED_LIFECYCLE_COUNTERS: LifecycleCounter[] = [
+  "copyConstructed",
+  "moveConstructed",
+  "copyAssigned",
+  "moveAssigned",
+];
+
+export type LifecycleGuess = Partial<Record<LifecycleCounter, number>>;
+
+export function emptyLifecycleGuess(): LifecycleGuess {
+  return Object.fromEntries(GUESSED_LIFECYCLE_COUNTERS.map((name) => [name, 0]));
+}
+
+/** Guessed counters that differ from the traced counts, in `GUESSED_LIFECYCLE_COUNTERS` order. */
+export function lifecycleMismatches(
+  guess: LifecycleGuess,
+  expected: LifecycleCounts
+): LifecycleCounter[] {
+  return GUESSED_LIFECYCLE_COUNTERS.filter((name) => (guess[name] ?? 0) !== expected[name]);
+}
@@ -0,0 +1,12 @@
+import type { OptimizationQuestion } from "./problems";
+
+export function optimizationQuestionText({ pass, line }: OptimizationQuestion): string {
+  return pass === "vectorize"
+    ? `Does GCC vectorize the loop on line ${line} at -O2?`
+    : `Is the call on line ${line} inlined at -O2?`;
+}
+
+export function optimizationAnswerText({ pass }: OptimizationQuestion, optimized: boolean): string {
+  if (pass === "vectorize") return optimized ? "Vectorized" : "Not vectorized";
+  return optimized ? "Inlined" : "Not inlined";
+}
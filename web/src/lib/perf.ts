@@ -0,0 +1,20 @@
+/**
+ * User Timing marks read by the browser benchmarks (`bench/web/browser.mjs`).
+ * A mark is a few bytes in the performance timeline: they stay on in production so the
+ * benchmarks measure the exported build as users get it.
+ */
+export const PERF_MARKS = {
+  /** First commit of the problem workspace on the client (end of hydration). */
+  workspaceHydrated: "gtocpp:workspace-hydrated",
+  /** DOM of a problem committed (`detail`: problem id). */
+  problemRendered: "gtocpp:problem-rendered",
+  /** The answer panel of a problem can take input. */
+  answerReady: "gtocpp:answer-ready",
+} as const;
+
+export type PerfMark = (typeof PERF_MARKS)[keyof typeof PERF_MARKS];
+
+export function markPerf(name: PerfMark, detail?: string) {
+  if (typeof performance === "undefined" || typeof performance.mark !== "function") return;
+  performance.mark(name, { detail });
+}
@@ -1,8 +1,3 @@
-import path from "path";
-import { promises as fs } from "fs";
-
-import { safeParse } from "./utils";
-
 export type ErrorType = "no-error" | "runtime-error" | "compilation-error" | "undefined-behavior";
 
 export type ErrorMessageColor = "default" | "red" | "yellow" | "cyan" | "green";
@@ -17,12 +12,178 @@ type ErrorMessagePart = {
 
 export type ErrorMessage = ErrorMessagePart[];
 
+/**
+ * Structure of an error message, as consecutive line ranges (see `diagnostic_sections` in
+ * `problems/run_all.py`).
+ * - "error": an error line and its source excerpt
+ * - "backtrace": the context printed before an error (enclosing function, instantiations)
+ * - "note": the notes following an error
+ * - "text": anything else
+ */
+export type DiagnosticKind = "error" | "backtrace" | "note" | "text";
+
+export type DiagnosticSection = {
+  kind: DiagnosticKind;
+  lines: number;
+};
+
+/**
+ * Special member calls of `gto::Traced` objects (`problems/include/gto/lifecycle.hpp`), counted
+ * over a whole run.
+ */
+export type LifecycleCounter =
+  | "constructed"
+  | "defaultConstructed"
+  | "copyConstructed"
+  | "moveConstructed"
+  | "copyAssigned"
+  | "moveAssigned"
+  | "destroyed";
+
+export type LifecycleCounts = Record<LifecycleCounter, number>;
+
+/** Optimizer remark on the problem's code (GCC `-fopt-info`, Clang `-Rpass`), at -O2. */
+export type RemarkKind = "optimized" | "missed";
+
+export type RemarkPass = "vectorize" | "inline" | "other";
+
+export type OptimizationRemark = {
+  line: number;
+  column: number;
+  kind: RemarkKind;
+  pass: RemarkPass;
+  message: string;
+};
+
+/** "optimization" problems: does the loop on `line` vectorize / is the call on `line` inlined? */
+export type OptimizationQuestion = {
+  pass: Exclude<RemarkPass, "other">;
+  line: number;
+};
+
+/**
+ * Record layout of a struct listed in `problems.json`, from the generated `offsetof` probe
+ * (`problems/include/gto/layout.hpp`). Members are in the listed order, not sorted by offset.
+ */
+export type LayoutMember = {
+  name: string;
+  offset: number;
+  size: number;
+  align: number;
+};
+
+export type RecordLayout = {
+  name: string;
+  size: number;
+  align: number;
+  members: LayoutMember[];
+  /** Hot loop over an array of it, on the generating machine (`run_all.py --layout-bench`). */
+  nsPerElement?: number;
+};
+
+/** ThreadSanitizer report of the schedule exploration (`line` is null outside the problem). */
+export type RaceReport = {
+  kind: string;
+  line: number | null;
+  function: string | null;
+};
+
+/**
+ * Concurrency problems: the instrumented build run once per seed with injected pauses (see
+ * `explore_schedules` in `problems/run_all.py`), with the distinct outputs and how often each
+ * one was seen. `failed` runs crashed or timed out.
+ */
+export type ScheduleExploration = {
+  runs: number;
+  failed: number;
+  outputs: { stdout: string; count: number }[];
+  races: RaceReport[];
+};
+
+/**
+ * Compile cost of one variant of a compile-time problem (`-DGTO_VARIANT=<index>`): median wall
+ * seconds over the kept `samples`, in total and for the frontend, template instantiation and
+ * constant evaluation phases, plus GC-allocated bytes and class template specializations, which
+ * do not vary between compiles. `classes` is null when the class dump failed.
+ */
+export type CompileTimeVariant = {
+  label: string;
+  seconds: number;
+  frontend: number;
+  instantiation: number;
+  constexpr: number;
+  memory: number;
+  classes: number | null;
+  samples: number[];
+};
+
+/** Timings of every variant (see `measure_compile_time` in `problems/run_all.py`). */
+export type CompileTimeReport = {
+  /** Index of the variant with the lowest median. */
+  fastest: number;
+  variants: CompileTimeVariant[];
+};
+
+/** `length` consecutive lines from `line` on, each executed `count` times (gcov, at -O0). */
+export type LineCountRun = {
+  line: number;
+  length: number;
+  count: number;
+};
+
+/**
+ * One `operator new` (`alloc`) or `operator delete` (`free`) of the heap timeline run (see
+ * `heap_timeline` in `problems/run_all.py`). Blocks are numbered in allocation order, a release
+ * carries the size of its block, and `line` is the number of lines of output written before.
+ */
+export type HeapEvent = {
+  op: "alloc" | "free";
+  block: number;
+  bytes: number;
+  line: number;
+};
+
+/** `truncated`: the run made more heap calls than the instrumentation records. */
+export type HeapTimeline = {
+  events: HeapEvent[];
+  truncated: boolean;
+};
+
 export type ProblemResult = {
   errorType: ErrorType;
   stdout?: string;
   errorMessage?: ErrorMessage;
+  errorSections?: DiagnosticSection[];
+  lifecycle?: LifecycleCounts;
+  remarks?: OptimizationRemark[];
+  /** Answer to the `optimization` question, from the remarks (null: no remark on that line). */
+  optimized?: boolean | null;
+  layout?: RecordLayout[];
+  schedules?: ScheduleExploration;
+  compileTime?: CompileTimeReport;
+  /** Execution counts of the lines that generate code (`run_all.py --coverage`). */
+  coverage?: LineCountRun[];
+  /** Allocations and releases of the whole run, by line of output (`heapTimeline` problems). */
+  heap?: HeapTimeline;
 };
 
+/**
+ * What the player answers:
+ * - "output": the outcome, and the exact stdout when it runs
+ * - "lifecycle": the copy and move counts of the traced objects (`result.lifecycle`)
+ * - "optimization": whether the optimization in `optimization` happens (`result.optimized`)
+ * - "layout": the size of every struct of `result.layout`
+ * - "outputs": which of `choices` are possible outputs (`result.schedules`)
+ * - "compileTime": which variant compiles fastest (`result.compileTime`)
+ */
+export type AnswerMode =
+  | "output"
+  | "lifecycle"
+  | "optimization"
+  | "layout"
+  | "outputs"
+  | "compileTime";
+
 export type ProblemDifficulty = 1 | 2 | 3 | 4 | 5;
 
 export type ProblemData = {
@@ -33,27 +194,289 @@ export type ProblemData = {
   concepts: string[];
   explanation: string;
   stdin?: string;
+  answerMode?: AnswerMode; // "output" when absent
+  optimization?: OptimizationQuestion;
+  /** Name of the -O0/-O2 assembly listing (see `loadAsmListing`), when the code compiles. */
+  asm?: string;
+  /** Candidate stdouts of concurrency problems, for the "outputs" answer mode. */
+  choices?: string[];
   result: ProblemResult;
 };
 
-export async function loadProblems(): Promise<ProblemData[]> {
-  const filePath = path.join(process.cwd(), "data", "problems.generated.json");
-  const raw = await fs.readFile(filePath, "utf8");
-  const json = safeParse(raw);
-  if (!json) return [];
-  return json as ProblemData[];
+/**
+ * Compact encoding emitted by `problems/run_all.py` (`web/data/problems.compact.json`).
+ * Problems are positional tuples (see `fields`), concepts index the `concepts` string table and
+ * error messages are flat `[paletteIndex, text, ...]` runs over the `palette` of styles, and their
+ * structure flat `[kindIndex, lineCount, ...]` pairs over `diagnosticKinds`. Lifecycle counts are
+ * in `lifecycleCounters` order, remarks flat `[line, column, kindIndex, passIndex, message, ...]`
+ * records over `remarkKinds` and `remarkPasses`. Assembly listings are separate files, `asm` only
+ * names them. Record layouts are `[name, size, align, [member, offset, size, align, ...], ns?]`,
+ * schedule explorations `[runs, failed, [stdout, count, ...], [kind, line, function, ...]]`,
+ * compile timings `[fastest, [label, seconds, frontend, instantiation, constexpr, memory,
+ * classes, samples], ...]`, line coverage flat `[line, length, count, ...]` runs, heap timelines
+ * `[truncated, line, block, bytes, ...]` with line and block as deltas from the previous event.
+ * Trailing null fields are left out.
+ */
+export type CompactProblemsData = {
+  format: 1;
+  fields: string[];
+  errorTypes: ErrorType[];
+  diagnosticKinds: DiagnosticKind[];
+  lifecycleCounters: LifecycleCounter[];
+  remarkKinds: RemarkKind[];
+  remarkPasses: RemarkPass[];
+  palette: [ErrorMessageColor, ErrorMessageStyle][];
+  concepts: string[];
+  problems: CompactProblem[];
+};
+
+type CompactProblem = [
+  id: string,
+  title: string,
+  difficulty: ProblemDifficulty,
+  concepts: number[],
+  explanation: string,
+  code: string,
+  stdin: string | null,
+  errorType: number,
+  result: string | (number | string)[] | null, // stdout | error runs | nothing (UB)
+  sections?: number[] | null,
+  answerMode?: AnswerMode | null, // null for "output"
+  lifecycle?: number[] | null,
+  optimization?: [passIndex: number, line: number, optimized: boolean | null] | null,
+  remarks?: (number | string)[] | null,
+  asm?: string | null,
+  layout?: CompactRecordLayout[] | null,
+  schedules?: CompactScheduleExploration | null,
+  choices?: string[] | null,
+  compileTime?: [fastest: number, ...variants: CompactCompileTimeVariant[]] | null,
+  coverage?: number[] | null,
+  heap?: number[] | null,
+];
+
+type CompactCompileTimeVariant = [
+  label: string,
+  seconds: number,
+  frontend: number,
+  instantiation: number,
+  constexpr: number,
+  memory: number,
+  classes: number | null,
+  samples: number[],
+];
+
+type CompactScheduleExploration = [
+  runs: number,
+  failed: number,
+  outputs: (number | string)[],
+  races: (number | string | null)[],
+];
+
+type CompactRecordLayout = [
+  name: string,
+  size: number,
+  align: number,
+  members: (number | string)[],
+  nsPerElement?: number,
+];
+
+function decodeErrorMessage(runs: (number | string)[], data: CompactProblemsData): ErrorMessage {
+  const message: ErrorMessage = [];
+  for (let i = 0; i + 1 < runs.length; i += 2) {
+    const [color, style] = data.palette[runs[i as number] as number];
+    message.push({ color, style, text: runs[i + 1] as string });
+  }
+  return message;
 }
 
-let problemsByIdPromise: Promise<Map<string, ProblemData>> | null = null;
+function decodeSections(flat: number[], data: CompactProblemsData): DiagnosticSection[] {
+  const sections: DiagnosticSection[] = [];
+  for (let i = 0; i + 1 < flat.length; i += 2) {
+    sections.push({ kind: data.diagnosticKinds[flat[i as number]], lines: flat[i + 1] });
+  }
+  return sections;
+}
+
+function decodeRemarks(
+  flat: (number | string)[],
+  data: CompactProblemsData
+): OptimizationRemark[] {
+  const remarks: OptimizationRemark[] = [];
+  for (let i = 0; i + 4 < flat.length; i += 5) {
+    remarks.push({
+      line: flat[i as number] as number,
+      column: flat[i + 1] as number,
+      kind: data.remarkKinds[flat[i + 2] as number],
+      pass: data.remarkPasses[flat[i + 3] as number],
+      message: flat[i + 4] as string,
+    });
+  }
+  return remarks;
+}
+
+function decodeLayout([name, size, align, flat, nsPerElement]: CompactRecordLayout): RecordLayout {
+  const members: LayoutMember[] = [];
+  for (let i = 0; i + 3 < flat.length; i += 4) {
+    members.push({
+      name: flat[i as number] as string,
+      offset: flat[i + 1] as number,
+      size: flat[i + 2] as number,
+      align: flat[i + 3] as number,
+    });
+  }
+  return { name, size, align, members, ...(nsPerElement != null ? { nsPerElement } : {}) };
+}
 
-export function loadProblemsById() {
-  if (!problemsByIdPromise) {
-    problemsByIdPromise = loadProblems().then((arr) => new Map(arr.map((p) => [p.id, p])));
+function decodeSchedules([runs, failed, flatOutputs, flatRaces]: CompactScheduleExploration) {
+  const schedules: ScheduleExploration = { runs, failed, outputs: [], races: [] };
+  for (let i = 0; i + 1 < flatOutputs.length; i += 2) {
+    schedules.outputs.push({
+      stdout: flatOutputs[i] as string,
+      count: flatOutputs[i + 1] as number,
+    });
   }
-  return problemsByIdPromise;
+  for (let i = 0; i + 2 < flatRaces.length; i += 3) {
+    schedules.races.push({
+      kind: flatRaces[i] as string,
+      line: flatRaces[i + 1] as number | null,
+      function: flatRaces[i + 2] as string | null,
+    });
+  }
+  return schedules;
+}
+
+function decodeCoverage(flat: number[]): LineCountRun[] {
+  const runs: LineCountRun[] = [];
+  for (let i = 0; i + 2 < flat.length; i += 3) {
+    runs.push({ line: flat[i], length: flat[i + 1], count: flat[i + 2] });
+  }
+  return runs;
+}
+
+/** A block above every earlier one is an allocation, any other a release (see `HeapEvent`). */
+function decodeHeapTimeline([truncated, ...flat]: number[]): HeapTimeline {
+  const events: HeapEvent[] = [];
+  let line = 0;
+  let block = 0;
+  let highest = 0;
+  for (let i = 0; i + 2 < flat.length; i += 3) {
+    line += flat[i];
+    block += flat[i + 1];
+    const op = block > highest ? "alloc" : "free";
+    highest = Math.max(highest, block);
+    events.push({ op, block, bytes: flat[i + 2], line });
+  }
+  return { events, truncated: truncated === 1 };
+}
+
+function decodeCompileTime([fastest, ...variants]: [
+  number,
+  ...CompactCompileTimeVariant[],
+]): CompileTimeReport {
+  return {
+    fastest,
+    variants: variants.map(
+      ([label, seconds, frontend, instantiation, constexpr, memory, classes, samples]) => ({
+        label,
+        seconds,
+        frontend,
+        instantiation,
+        constexpr,
+        memory,
+        classes,
+        samples,
+      })
+    ),
+  };
+}
+
+function decodeLifecycle(counts: number[], data: CompactProblemsData): LifecycleCounts {
+  return Object.fromEntries(
+    data.lifecycleCounters.map((name, i) => [name, counts[i as number]])
+  ) as LifecycleCounts;
+}
+
+export function decodeCompactProblems(data: CompactProblemsData): ProblemData[] {
+  if (data.format !== 1) throw new Error(`Unsupported problems format: ${data.format}`);
+
+  return data.problems.map(
+    ([
+      id,
+      title,
+      difficulty,
+      concepts,
+      explanation,
+      code,
+      stdin,
+      errorTypeIndex,
+      payload,
+      sections,
+      answerMode,
+      lifecycle,
+      optimization,
+      remarks,
+      asm,
+      layout,
+      schedules,
+      choices,
+      compileTime,
+      coverage,
+      heap,
+    ]) => {
+      const errorType = data.errorTypes[errorTypeIndex as number];
+      const result: ProblemResult = { errorType };
+      if (errorType === "no-error") {
+        result.stdout = payload as string;
+      } else if (Array.isArray(payload)) {
+        result.errorMessage = decodeErrorMessage(payload, data);
+        if (sections) result.errorSections = decodeSections(sections, data);
+      }
+      if (lifecycle) result.lifecycle = decodeLifecycle(lifecycle, data);
+      if (remarks) result.remarks = decodeRemarks(remarks, data);
+      if (optimization) result.optimized = optimization[2];
+      if (layout) result.layout = layout.map(decodeLayout);
+      if (schedules) result.schedules = decodeSchedules(schedules);
+      if (compileTime) result.compileTime = decodeCompileTime(compileTime);
+      if (coverage) result.coverage = decodeCoverage(coverage);
+      if (heap) result.heap = decodeHeapTimeline(heap);
+
+      return {
+        id,
+        title,
+        difficulty,
+        concepts: concepts.map((c) => data.concepts[c as number]),
+        explanation,
+        code,
+        ...(stdin != null ? { stdin } : {}),
+        ...(answerMode != null ? { answerMode } : {}),
+        ...(optimization
+          ? {
+              optimization: {
+                pass: data.remarkPasses[optimization[0]] as OptimizationQuestion["pass"],
+                line: optimization[1],
+              },
+            }
+          : {}),
+        ...(asm != null ? { asm } : {}),
+        ...(choices != null ? { choices } : {}),
+        result,
+      };
+    }
+  );
 }
 
-export async function getProblem(id: string) {
-  const map = await loadProblemsById();
-  return map.get(id);
+/**
+ * `data` as sent to the client by the training page: without the code and explanations, which
+ * are rendered on the server. Decoded problems then have both empty.
+ */
+export function withoutRenderedFields(data: CompactProblemsData): CompactProblemsData {
+  return {
+    ...data,
+    problems: data.problems.map((problem) => {
+      const copy: CompactProblem = [...problem];
+      copy[4] = "";
+      copy[5] = "";
+      return copy;
+    }),
+  };
 }
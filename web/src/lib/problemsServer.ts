@@ -0,0 +1,28 @@
+// Server-only readers of the generated problems (`web/data/`, read from disk).
+import path from "path";
+import { promises as fs } from "fs";
+
+import { CompactProblemsData, ProblemData, decodeCompactProblems } from "./problems";
+import { safeParse } from "./utils";
+
+export async function loadProblems(): Promise<ProblemData[]> {
+  const filePath = path.join(process.cwd(), "data", "problems.compact.json");
+  const raw = await fs.readFile(filePath, "utf8");
+  const json = safeParse(raw);
+  if (!json) return [];
+  return decodeCompactProblems(json as CompactProblemsData);
+}
+
+let problemsByIdPromise: Promise<Map<string, ProblemData>> | null = null;
+
+export function loadProblemsById() {
+  if (!problemsByIdPromise) {
+    problemsByIdPromise = loadProblems().then((arr) => new Map(arr.map((p) => [p.id, p])));
+  }
+  return problemsByIdPromise;
+}
+
+export async function getProblem(id: string) {
+  const map = await loadProblemsById();
+  return map.get(id);
+}
@@ -0,0 +1,31 @@
+import type { ScheduleExploration } from "./problems";
+
+/** Times `stdout` was printed over the explored schedules (0: never observed). */
+export function observedCount(stdout: string, schedules: ScheduleExploration): number {
+  return schedules.outputs.find((output) => output.stdout === stdout)?.count ?? 0;
+}
+
+/** Choices some explored schedule printed: the answer of the "outputs" mode, in `choices` order. */
+export function possibleChoices(choices: string[], schedules: ScheduleExploration): string[] {
+  return choices.filter((choice) => observedCount(choice, schedules) > 0);
+}
+
+/** Choices wrongly selected or wrongly left out, in `choices` order. */
+export function outputsMismatches(
+  selected: string[],
+  choices: string[],
+  schedules: ScheduleExploration
+): string[] {
+  const possible = possibleChoices(choices, schedules);
+  return choices.filter((choice) => selected.includes(choice) !== possible.includes(choice));
+}
+
+/** Observed outputs the problem author did not list as choices. */
+export function unlistedOutputs(choices: string[], schedules: ScheduleExploration) {
+  return schedules.outputs.filter((output) => !choices.includes(output.stdout));
+}
+
+/** One-line rendering of a stdout: line breaks as ⏎, the trailing one dropped. */
+export function inlineStdout(stdout: string): string {
+  return stdout.replace(/\n$/, "").replaceAll("\n", " ⏎ ") || "(empty)";
+}
@@ -0,0 +1,53 @@
+import { SEARCH_INDEX_URL, type SearchIndexData, type SearchResult, search } from "./engine";
+import { loadSearchIndex } from "./load";
+import type { SearchWorkerRequest, SearchWorkerResponse } from "./search.worker";
+
+type Pending = { resolve: (result: SearchResult | null) => void; reject: (e: Error) => void };
+
+let worker: Worker | null = null;
+let nextRequestId = 1;
+const pending = new Map<number, Pending>();
+
+let inlineIndexPromise: Promise<SearchIndexData> | null = null;
+
+function getSearchWorker(): Worker | null {
+  if (typeof window === "undefined" || typeof Worker === "undefined") return null;
+
+  if (!worker) {
+    worker = new Worker(new URL("./search.worker.ts", import.meta.url));
+    worker.addEventListener("message", (event: MessageEvent<SearchWorkerResponse>) => {
+      const response = event.data;
+      const request = pending.get(response.id);
+      pending.delete(response.id);
+      if (!request) return;
+      if ("error" in response) request.reject(new Error(response.error));
+      else request.resolve(response.result);
+    });
+  }
+  return worker;
+}
+
+/** Load the index early (e.g. when the search box gets focus), without searching. */
+export function preloadSearch() {
+  getSearchWorker()?.postMessage({ id: 0, query: "" } satisfies SearchWorkerRequest);
+}
+
+/**
+ * Search problems off the main thread. The index is only downloaded on the first query.
+ * Resolves with `null` when a newer query superseded this one.
+ * Falls back to searching on the main thread where workers are unavailable.
+ */
+export function searchProblems(query: string, limit?: number): Promise<SearchResult | null> {
+  const w = getSearchWorker();
+  if (!w) {
+    inlineIndexPromise ??= loadSearchIndex(SEARCH_INDEX_URL);
+    return inlineIndexPromise.then((index) => search(index, query, limit));
+  }
+
+  const id = nextRequestId++;
+  const result = new Promise<SearchResult | null>((resolve, reject) =>
+    pending.set(id, { resolve, reject })
+  );
+  w.postMessage({ id, query, limit } satisfies SearchWorkerRequest);
+  return result;
+}
@@ -0,0 +1,133 @@
+import type { ProblemDifficulty } from "@/lib/problems";
+
+/**
+ * Problem search over the inverted index built by `problems/run_all.py`
+ * (`public/generated/search-index.json`).
+ *
+ * Every query word is prefix-matched against the sorted term list, so results update while
+ * typing. A problem must match all words; it is ranked by the sum of
+ * `weight (field-weighted tf) × idf` of the matching terms, exact terms counting more than
+ * prefix expansions. A common word matches every problem, and so does a word that is the prefix
+ * of one (it may still be typed in full); their expansions among the indexed terms still score.
+ * A query of only such words lists every problem.
+ */
+
+export const SEARCH_INDEX_URL = "/generated/search-index.json";
+
+export type SearchIndexData = {
+  format: 1;
+  problemIds: string[];
+  titles: string[];
+  difficulties: ProblemDifficulty[];
+  common: string[]; // too frequent to be indexed: they match every problem
+  terms: string[]; // sorted
+  postings: number[][]; // aligned with `terms`: [positionDelta, weight, ...]
+};
+
+export type SearchHit = {
+  id: string;
+  title: string;
+  difficulty: ProblemDifficulty;
+  score: number;
+};
+
+export type SearchResult = {
+  query: string;
+  hits: SearchHit[]; // best first, at most `limit`
+  ids: string[]; // every match, best first (e.g. to start a session)
+  tookMs: number;
+};
+
+/** Prefix expansions per query word: bounds the work of short prefixes. */
+const MAX_PREFIX_EXPANSIONS = 64;
+const PREFIX_MATCH_FACTOR = 0.5;
+const DEFAULT_LIMIT = 50;
+
+/** Same stop words as the generator (`SEARCH_STOP_WORDS`). */
+const STOP_WORDS = new Set(
+  (
+    "a an and are as at be but by can do does for from has have here if in is it its not of on " +
+    "or so than that the then there this to was we when which will with you your"
+  ).split(" ")
+);
+
+const WORD_PATTERN = /[a-z0-9_]+/g;
+
+/** Query words: lowercase, no stop words, no bare numbers (they are not indexed). */
+export function queryWords(query: string): string[] {
+  const words = query.toLowerCase().match(WORD_PATTERN) ?? [];
+  return Array.from(new Set(words.filter((w) => !STOP_WORDS.has(w) && !/^\d+$/.test(w))));
+}
+
+export function validateSearchIndex(data: SearchIndexData): SearchIndexData {
+  if (data.format !== 1) throw new Error(`Unsupported search index format: ${data.format}`);
+  return data;
+}
+
+function lowerBound(terms: string[], word: string) {
+  let lo = 0;
+  let hi = terms.length;
+  while (lo < hi) {
+    const mid = (lo + hi) >>> 1;
+    if (terms[mid as number] < word) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+export function search(index: SearchIndexData, query: string, limit = DEFAULT_LIMIT): SearchResult {
+  const t0 = performance.now();
+  const n = index.problemIds.length;
+
+  const words = queryWords(query);
+  if (words.length === 0) return { query, hits: [], ids: [], tookMs: performance.now() - t0 };
+
+  const scores = new Float64Array(n);
+  const matchedWords = new Uint16Array(n);
+  const seenAt = new Int32Array(n).fill(-1); // last word that matched each problem
+
+  words.forEach((word, w) => {
+    if (index.common.some((term) => term.startsWith(word))) {
+      seenAt.fill(w);
+      for (let pos = 0; pos < n; pos++) matchedWords[pos as number]++;
+    }
+
+    const start = lowerBound(index.terms, word);
+    for (let t = start; t < index.terms.length && t - start < MAX_PREFIX_EXPANSIONS; t++) {
+      const term = index.terms[t as number];
+      if (!term.startsWith(word)) break;
+
+      const postings = index.postings[t as number];
+      const df = postings.length / 2;
+      const idf = Math.log(1 + n / df) * (term === word ? 1 : PREFIX_MATCH_FACTOR);
+
+      let pos = 0;
+      for (let i = 0; i < postings.length; i += 2) {
+        pos += postings[i as number];
+        scores[pos as number] += postings[i + 1] * idf;
+        if (seenAt[pos as number] !== w) {
+          seenAt[pos as number] = w;
+          matchedWords[pos as number]++;
+        }
+      }
+    }
+  });
+
+  const matches: number[] = [];
+  for (let pos = 0; pos < n; pos++) {
+    if (matchedWords[pos as number] === words.length) matches.push(pos);
+  }
+  matches.sort((a, b) => scores[b as number] - scores[a as number] || a - b);
+
+  return {
+    query,
+    hits: matches.slice(0, limit).map((pos) => ({
+      id: index.problemIds[pos as number],
+      title: index.titles[pos as number],
+      difficulty: index.difficulties[pos as number],
+      score: scores[pos as number],
+    })),
+    ids: matches.map((pos) => index.problemIds[pos as number]),
+    tookMs: performance.now() - t0,
+  };
+}
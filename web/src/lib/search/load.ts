@@ -0,0 +1,7 @@
+import { type SearchIndexData, validateSearchIndex } from "./engine";
+
+export async function loadSearchIndex(url: string): Promise<SearchIndexData> {
+  const response = await fetch(url);
+  if (!response.ok) throw new Error(`Cannot load the search index (${response.status})`);
+  return validateSearchIndex((await response.json()) as SearchIndexData);
+}
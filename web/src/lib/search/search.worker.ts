@@ -0,0 +1,53 @@
+import { SEARCH_INDEX_URL, type SearchIndexData, type SearchResult, search } from "./engine";
+import { loadSearchIndex } from "./load";
+
+/**
+ * Search worker: loads the index once, then answers queries.
+ * Only the latest query is computed; queries still waiting behind it get `result: null`.
+ */
+
+export type SearchWorkerRequest = { id: number; query: string; limit?: number };
+
+export type SearchWorkerResponse =
+  | { id: number; result: SearchResult | null }
+  | { id: number; error: string };
+
+let latest: SearchWorkerRequest | null = null;
+let running = false;
+let indexPromise: Promise<SearchIndexData> | null = null;
+
+function reply(response: SearchWorkerResponse) {
+  self.postMessage(response);
+}
+
+async function drain() {
+  if (running) return;
+  running = true;
+
+  while (latest) {
+    const job = latest;
+    latest = null;
+
+    try {
+      indexPromise ??= loadSearchIndex(new URL(SEARCH_INDEX_URL, self.location.origin).href);
+      const index = await indexPromise;
+
+      // Superseded while the index was loading: the newer query is answered instead.
+      if (latest) reply({ id: job.id, result: null });
+      else reply({ id: job.id, result: search(index, job.query, job.limit) });
+    } catch (error) {
+      indexPromise = null;
+      reply({ id: job.id, error: String(error) });
+    }
+  }
+
+  running = false;
+}
+
+self.addEventListener("message", (event: MessageEvent<SearchWorkerRequest>) => {
+  if (latest) reply({ id: latest.id, result: null });
+  latest = event.data;
+
+  // Let queued keystrokes arrive before searching, so bursts collapse into one query.
+  setTimeout(drain, 0);
+});
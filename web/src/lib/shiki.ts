@@ -1,4 +1,4 @@
-import { type Highlighter, createHighlighter } from "shiki";
+import { type Highlighter, type ShikiTransformer, createHighlighter } from "shiki";
 
 let highlighterPromise: Promise<Highlighter> | null = null;
 
@@ -11,3 +11,10 @@ export function getCppHighlighter() {
   }
   return highlighterPromise;
 }
+
+/** Tags every `.line` with its 1-based number (`data-line`), for per-line overlays. */
+export const lineNumberTransformer: ShikiTransformer = {
+  line(node, line) {
+    node.properties["data-line"] = line;
+  },
+};
@@ -25,6 +25,12 @@ export type TrainingConfig = {
 
   problemOrder: ProblemOrder;
   showOutputDifference: boolean;
+
+  /**
+   * Sampling seed: the same seed and filters rebuild the same session.
+   * `null` (or absent, for older sessions) = pick one at random; sessions store the seed used.
+   */
+  seed?: number | null;
 };
 
 export const defaultTrainingConfig: TrainingConfig = {
@@ -37,6 +43,7 @@ export const defaultTrainingConfig: TrainingConfig = {
   sessionTimer: null,
   problemOrder: "random",
   showOutputDifference: true,
+  seed: null,
 };
 
 export const presets: Array<{
@@ -0,0 +1,179 @@
+import type { TrainingAttempt, TrainingSession } from "./model";
+
+/**
+ * Asynchronous archive for finished training sessions and per-attempt history.
+ *
+ * localStorage only keeps the sessions that can still be played (see `storage.ts`), so the
+ * synchronous store stays small. Everything that only needs to be *listed* lives here, in
+ * IndexedDB, and is queried through indexes instead of being parsed on every store change.
+ */
+
+const DB_NAME = "gtocpp.training";
+const DB_VERSION = 1;
+
+const SESSIONS_STORE = "sessions";
+const ATTEMPTS_STORE = "attempts";
+
+const HISTORY_EVENT = "gtocpp.training.history.changed";
+
+export function isHistoryAvailable() {
+  return typeof window !== "undefined" && typeof window.indexedDB !== "undefined";
+}
+
+function requestToPromise<T>(request: IDBRequest<T>): Promise<T> {
+  return new Promise((resolve, reject) => {
+    request.onsuccess = () => resolve(request.result);
+    request.onerror = () => reject(request.error);
+  });
+}
+
+function transactionDone(tx: IDBTransaction): Promise<void> {
+  return new Promise((resolve, reject) => {
+    tx.oncomplete = () => resolve();
+    tx.onerror = () => reject(tx.error);
+    tx.onabort = () => reject(tx.error ?? new Error("IndexedDB transaction aborted"));
+  });
+}
+
+let dbPromise: Promise<IDBDatabase> | null = null;
+
+function openHistoryDb(): Promise<IDBDatabase> {
+  if (!isHistoryAvailable()) {
+    return Promise.reject(new Error("IndexedDB is not available"));
+  }
+
+  if (!dbPromise) {
+    const request = window.indexedDB.open(DB_NAME, DB_VERSION);
+
+    request.onupgradeneeded = () => {
+      const db = request.result;
+
+      if (!db.objectStoreNames.contains(SESSIONS_STORE)) {
+        const sessions = db.createObjectStore(SESSIONS_STORE, { keyPath: "meta.id" });
+        sessions.createIndex("lastOpenedAt", "meta.lastOpenedAt");
+      }
+
+      if (!db.objectStoreNames.contains(ATTEMPTS_STORE)) {
+        const attempts = db.createObjectStore(ATTEMPTS_STORE, {
+          keyPath: "id",
+          autoIncrement: true,
+        });
+        attempts.createIndex("sessionId", "sessionId");
+        attempts.createIndex("problemId", "problemId");
+      }
+    };
+
+    dbPromise = requestToPromise(request).catch((error) => {
+      // Allow a later call to retry (e.g. after the user closed a blocking tab).
+      dbPromise = null;
+      throw error;
+    });
+  }
+
+  return dbPromise;
+}
+
+function notifyHistoryChanged() {
+  window.dispatchEvent(new Event(HISTORY_EVENT));
+}
+
+/** Subscribe to writes made to the archive from this tab. */
+export function subscribeHistory(listener: () => void): () => void {
+  if (!isHistoryAvailable()) return () => {};
+
+  window.addEventListener(HISTORY_EVENT, listener);
+  return () => window.removeEventListener(HISTORY_EVENT, listener);
+}
+
+/** Store (or overwrite) finished sessions in the archive. */
+export async function archiveSessions(sessions: TrainingSession[]): Promise<void> {
+  if (sessions.length === 0) return;
+
+  const db = await openHistoryDb();
+  const tx = db.transaction(SESSIONS_STORE, "readwrite");
+  const store = tx.objectStore(SESSIONS_STORE);
+  for (const session of sessions) {
+    store.put(session);
+  }
+  await transactionDone(tx);
+
+  notifyHistoryChanged();
+}
+
+/** The `limit` most recently used archived sessions, newest first. */
+export async function listArchivedSessions(params: { limit: number }): Promise<TrainingSession[]> {
+  const db = await openHistoryDb();
+  const tx = db.transaction(SESSIONS_STORE, "readonly");
+  const index = tx.objectStore(SESSIONS_STORE).index("lastOpenedAt");
+
+  const sessions: TrainingSession[] = [];
+
+  await new Promise<void>((resolve, reject) => {
+    const request = index.openCursor(null, "prev");
+    request.onerror = () => reject(request.error);
+    request.onsuccess = () => {
+      const cursor = request.result;
+      if (!cursor || sessions.length >= params.limit) {
+        resolve();
+        return;
+      }
+      sessions.push(cursor.value as TrainingSession);
+      cursor.continue();
+    };
+  });
+
+  return sessions;
+}
+
+export async function countArchivedSessions(): Promise<number> {
+  const db = await openHistoryDb();
+  const tx = db.transaction(SESSIONS_STORE, "readonly");
+  return requestToPromise(tx.objectStore(SESSIONS_STORE).count());
+}
+
+/** Delete an archived session and all of its attempts. No-op for unknown ids. */
+export async function deleteArchivedSession(id: string): Promise<void> {
+  const db = await openHistoryDb();
+  const tx = db.transaction([SESSIONS_STORE, ATTEMPTS_STORE], "readwrite");
+
+  tx.objectStore(SESSIONS_STORE).delete(id);
+
+  const attemptsIndex = tx.objectStore(ATTEMPTS_STORE).index("sessionId");
+  const request = attemptsIndex.openKeyCursor(IDBKeyRange.only(id));
+  request.onsuccess = () => {
+    const cursor = request.result;
+    if (!cursor) return;
+    tx.objectStore(ATTEMPTS_STORE).delete(cursor.primaryKey);
+    cursor.continue();
+  };
+
+  await transactionDone(tx);
+
+  notifyHistoryChanged();
+}
+
+/** Append one submission to the attempt history. */
+export async function appendAttempt(attempt: TrainingAttempt): Promise<void> {
+  const db = await openHistoryDb();
+  const tx = db.transaction(ATTEMPTS_STORE, "readwrite");
+  tx.objectStore(ATTEMPTS_STORE).add(attempt);
+  await transactionDone(tx);
+}
+
+/** Every attempt of a session, in submission order. */
+export async function listSessionAttempts(sessionId: string): Promise<TrainingAttempt[]> {
+  const db = await openHistoryDb();
+  const tx = db.transaction(ATTEMPTS_STORE, "readonly");
+  const index = tx.objectStore(ATTEMPTS_STORE).index("sessionId");
+  const attempts = await requestToPromise(index.getAll(IDBKeyRange.only(sessionId)));
+  return (attempts as TrainingAttempt[]).sort((a, b) => a.at - b.at);
+}
+
+/** Every attempt on a problem, across all sessions, in submission order. */
+export async function listProblemAttempts(problemId: string): Promise<TrainingAttempt[]> {
+  const db = await openHistoryDb();
+  const tx = db.transaction(ATTEMPTS_STORE, "readonly");
+  const index = tx.objectStore(ATTEMPTS_STORE).index("problemId");
+  const attempts = await requestToPromise(index.getAll(IDBKeyRange.only(problemId)));
+  return (attempts as TrainingAttempt[]).sort((a, b) => a.at - b.at);
+}
@@ -1,5 +1,8 @@
 export * from "./model";
 export * from "./storage";
+export * from "./history";
 export * from "./sessions";
 export * from "./timers";
+export * from "./sampling";
+export * from "./sync";
 export * from "./config";
@@ -1,8 +1,16 @@
 import { TrainingConfig } from "@/lib/training/config";
 
-import { SubmissionEvaluation } from "@/components/sections/problem/ProblemWorkspace";
-
-export const TRAINING_CONFIG_VERSION = 1;
+import {
+  SubmissionEvaluation,
+  UserSubmission,
+} from "@/components/sections/problem/ProblemWorkspace";
+
+/**
+ * Version of the persisted store layout.
+ * v2: only playable sessions stay in localStorage (one key each), finished ones are archived in
+ * IndexedDB.
+ */
+export const TRAINING_CONFIG_VERSION = 2;
 
 export type SessionStatus = "active" | "completed";
 
@@ -50,6 +58,9 @@ export type TrainingSessionMeta = {
 export type TrainingSession = {
   meta: TrainingSessionMeta;
 
+  /** Revision, bumped on every write (detects concurrent writes from other tabs, see `sync.ts`). */
+  rev?: number;
+
   config: TrainingConfig;
 
   /**
@@ -72,6 +83,24 @@ export type TrainingSession = {
   };
 };
 
+/**
+ * One submission, as kept in the IndexedDB attempt history.
+ * - "solved": correct answer
+ * - "wrong": incorrect answer, the problem can still be attempted
+ * - "failed": the problem is over (gave up, timer expired or max attempts reached)
+ */
+export type AttemptOutcome = "solved" | "wrong" | "failed";
+
+export type TrainingAttempt = {
+  id?: number; // auto-incremented by IndexedDB
+  sessionId: string;
+  problemId: string;
+  submission?: UserSubmission;
+  outcome: AttemptOutcome;
+  timeTakenMs: number; // since the problem was shown
+  at: number; // ms
+};
+
 export type TrainingStore = {
   version: typeof TRAINING_CONFIG_VERSION;
   activeSessionId: string | null;
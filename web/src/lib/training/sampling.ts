@@ -0,0 +1,152 @@
+/**
+ * Seedable sampling used to build training sessions.
+ *
+ * Every draw goes through an explicit `Rng`, so a session can be rebuilt from its seed (same seed,
+ * same filters, same problem set → same problems in the same order).
+ */
+
+/** Uniform uint32 generator. */
+export type Rng = () => number;
+
+/** Seeds are uint32 so they stay short enough to be shared. */
+export function randomSeed(): number {
+  if (typeof crypto !== "undefined" && typeof crypto.getRandomValues === "function") {
+    return crypto.getRandomValues(new Uint32Array(1))[0];
+  }
+  // eslint-disable-next-line sonarjs/pseudo-random
+  return Math.floor(Math.random() * 0x100000000) >>> 0;
+}
+
+/** Accepts a non-negative integer below 2^32; anything else is `null`. */
+export function parseSeed(input: string): number | null {
+  const trimmed = input.trim();
+  if (!/^\d{1,10}$/.test(trimmed)) return null;
+  const n = Number(trimmed);
+  return n <= 0xffffffff ? n : null;
+}
+
+/** sfc32 (small fast counter) seeded from a uint32 through splitmix32. */
+export function createRng(seed: number): Rng {
+  let state = seed >>> 0;
+  const splitmix = () => {
+    state = (state + 0x9e3779b9) >>> 0;
+    let z = state;
+    z = Math.imul(z ^ (z >>> 16), 0x85ebca6b);
+    z = Math.imul(z ^ (z >>> 13), 0xc2b2ae35);
+    return (z ^ (z >>> 16)) >>> 0;
+  };
+
+  let a = splitmix();
+  let b = splitmix();
+  let c = splitmix();
+  let counter = 1;
+
+  const next = () => {
+    const t = (((a + b) | 0) + counter) | 0;
+    counter = (counter + 1) | 0;
+    a = b ^ (b >>> 9);
+    b = (c + (c << 3)) | 0;
+    c = (c << 21) | (c >>> 11);
+    c = (c + t) | 0;
+    return t >>> 0;
+  };
+
+  // Discard the first outputs, which are still correlated with the seed.
+  for (let i = 0; i < 12; i++) next();
+  return next;
+}
+
+/** Uniform integer in [0, n), without modulo bias. `n` must be in [1, 2^32]. */
+export function randomInt(rng: Rng, n: number): number {
+  const limit = 0x100000000 - (0x100000000 % n);
+  let x = rng();
+  while (x >= limit) x = rng();
+  return x % n;
+}
+
+/**
+ * `k` distinct items drawn uniformly, in uniformly random order (partial Fisher–Yates).
+ * Only the swapped slots are remembered, so this is O(k) time and memory whatever the
+ * size of `items`.
+ */
+export function sampleWithoutReplacement<T>(items: readonly T[], k: number, rng: Rng): T[] {
+  const n = items.length;
+  const count = Math.max(0, Math.min(k, n));
+  const swapped = new Map<number, number>(); // slot -> index of the item now in that slot
+  const out: T[] = new Array(count);
+
+  for (let i = 0; i < count; i++) {
+    const j = i + randomInt(rng, n - i);
+    const picked = swapped.get(j) ?? j;
+    swapped.set(j, swapped.get(i) ?? i);
+    out[i as number] = items[picked as number];
+  }
+
+  return out;
+}
+
+/** Uniform in-place shuffle (Fisher–Yates). */
+export function shuffleInPlace<T>(items: T[], rng: Rng): T[] {
+  for (let i = items.length - 1; i > 0; i--) {
+    const j = randomInt(rng, i + 1);
+    const tmp = items[i as number];
+    items[i as number] = items[j as number];
+    items[j as number] = tmp;
+  }
+  return items;
+}
+
+/**
+ * Split `k` across strata proportionally to their sizes (largest remainder method).
+ * Never gives a stratum more than it holds; the total is `min(k, sum of sizes)`.
+ */
+export function allocateProportionally(sizes: number[], k: number): number[] {
+  const total = sizes.reduce((a, b) => a + b, 0);
+  const count = Math.max(0, Math.min(k, total));
+  if (total === 0) return sizes.map(() => 0);
+
+  const quotas = sizes.map((size) => (count * size) / total);
+  const alloc = quotas.map(Math.floor);
+  let left = count - alloc.reduce((a, b) => a + b, 0);
+
+  // floor(q) < q <= size, so rounding any fractional quota up stays within its stratum.
+  const byRemainder = quotas
+    .map((q, i) => ({ i, r: q - Math.floor(q) }))
+    .sort((x, y) => y.r - x.r || x.i - y.i);
+  for (const { i } of byRemainder) {
+    if (left === 0) break;
+    alloc[i as number]++;
+    left--;
+  }
+
+  return alloc;
+}
+
+/**
+ * Stratified sample: `k` items split across strata proportionally to their sizes, each stratum
+ * sampled uniformly. Strata are returned in ascending key order (e.g. difficulty ramp), items
+ * inside a stratum in random order.
+ */
+export function stratifiedSample<T>(
+  items: readonly T[],
+  k: number,
+  stratumOf: (item: T) => number,
+  rng: Rng
+): T[] {
+  const strata = new Map<number, T[]>();
+  for (const item of items) {
+    const key = stratumOf(item);
+    let stratum = strata.get(key);
+    if (!stratum) {
+      stratum = [];
+      strata.set(key, stratum);
+    }
+    stratum.push(item);
+  }
+
+  const keys = Array.from(strata.keys()).sort((a, b) => a - b);
+  const groups = keys.map((key) => strata.get(key)!);
+  const alloc = allocateProportionally(groups.map((g) => g.length), k);
+
+  return groups.flatMap((group, i) => sampleWithoutReplacement(group, alloc[i as number], rng));
+}
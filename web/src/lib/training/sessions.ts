@@ -6,8 +6,19 @@ import {
 } from "@/components/sections/problem/ProblemWorkspace";
 
 import { now } from "../utils";
-import { TrainingSession, TrainingStore } from "./model";
-import { loadStore, newId, updateStore } from "./storage";
+import { AttemptOutcome, TrainingSession, TrainingStore } from "./model";
+import { hasLegacyStore, loadStore, newId, saveStore, updateStore } from "./storage";
+import {
+  appendAttempt,
+  archiveSessions,
+  deleteArchivedSession,
+  isHistoryAvailable,
+} from "./history";
+
+/** History writes never block the game: failures only cost the archived copy. */
+function runInBackground(task: Promise<unknown>) {
+  task.catch((error) => console.warn("Training history update failed:", error));
+}
 
 function defaultScore() {
   return {
@@ -48,6 +59,10 @@ export function ensureSessionExists(store: TrainingStore, id: string): TrainingS
   return s;
 }
 
+/**
+ * Sessions still kept in localStorage (playable ones, plus the active one even if finished).
+ * Archived sessions are listed with `listArchivedSessions`.
+ */
 export function listTrainingSessions(): TrainingSession[] {
   const store = loadStore();
   return Object.values(store.sessionsById).sort(
@@ -70,6 +85,41 @@ export function getActiveTrainingSession(): TrainingSession | null {
   return store.sessionsById[store.activeSessionId] ?? null;
 }
 
+function isArchivable(store: TrainingStore, s: TrainingSession) {
+  return s.meta.status === "completed" && s.meta.id !== store.activeSessionId;
+}
+
+/**
+ * Move finished sessions (other than the active one, which can still be retried) from
+ * localStorage to the IndexedDB archive. Sessions are only dropped from localStorage once the
+ * archive write succeeded, and only if they were not resumed in the meantime.
+ */
+export async function archiveCompletedSessions(): Promise<void> {
+  if (!isHistoryAvailable()) return;
+
+  // Rewrite a v1 store under the v2 keys first.
+  if (hasLegacyStore()) saveStore(loadStore());
+
+  const store = loadStore();
+  const archivable = Object.values(store.sessionsById).filter((s) => isArchivable(store, s));
+  if (archivable.length === 0) return;
+
+  await archiveSessions(archivable);
+
+  updateStore((prev) => {
+    const sessionsById = { ...prev.sessionsById };
+    let changed = false;
+    for (const s of archivable) {
+      const current = sessionsById[s.meta.id];
+      if (current && isArchivable(prev, current)) {
+        delete sessionsById[s.meta.id];
+        changed = true;
+      }
+    }
+    return changed ? { ...prev, sessionsById } : prev;
+  });
+}
+
 export function setActiveTrainingSession(id: string | null): void {
   updateStore((store) => {
     if (id && !store.sessionsById[id as string]) {
@@ -120,10 +170,14 @@ export function createTrainingSession(params: {
     };
   });
 
+  runInBackground(archiveCompletedSessions());
+
   return id;
 }
 
 export function deleteTrainingSession(id: string): void {
+  if (isHistoryAvailable()) runInBackground(deleteArchivedSession(id));
+
   updateStore((store) => {
     if (!(id in store.sessionsById)) return store;
 
@@ -193,12 +247,18 @@ export function recordAttempt(
 } {
   let finishedProblem = false;
   let finishedSession = false;
+  // Filled by the updater (assignments in callbacks are invisible to TS narrowing).
+  let problemId = null as string | null;
+  let problemStartedAt = 0;
+  const t = now();
 
   updateStore((store) => {
     const s = ensureSessionExists(store, sessionId);
-    const t = now();
 
     const currentIndex = s.progress.currentIndex;
+    problemId = s.problemIds[currentIndex as number] ?? null;
+    problemStartedAt = s.progress.timers.problemStartedAt ?? s.progress.startedAt;
+
     const atLastProblem = currentIndex >= s.problemIds.length - 1;
 
     const attemptsOnCurrent = s.progress.attemptsOnCurrent + 1;
@@ -253,6 +313,7 @@ export function recordAttempt(
             ...nextSession.progress,
             currentIndex: currentIndex + 1,
             attemptsOnCurrent: 0,
+            timers: { ...nextSession.progress.timers, problemStartedAt: t },
           },
         };
       }
@@ -264,6 +325,23 @@ export function recordAttempt(
     };
   });
 
+  if (problemId && isHistoryAvailable()) {
+    let outcome: AttemptOutcome = "wrong";
+    if (evaluation.success) outcome = "solved";
+    else if (finishedProblem) outcome = "failed";
+
+    runInBackground(
+      appendAttempt({
+        sessionId,
+        problemId,
+        submission: submission ?? evaluation.submission,
+        outcome,
+        timeTakenMs: Math.max(0, t - problemStartedAt),
+        at: t,
+      })
+    );
+  }
+
   return { finishedProblem, finishedSession };
 }
 
@@ -306,6 +384,7 @@ export function retryLastProblem(sessionId: string): string | null {
         timers: {
           ...s.progress.timers,
           problemSecondsRemaining: s.config.problemTimer,
+          problemStartedAt: t,
           lastTickAt: null,
         },
       },
@@ -1,8 +1,13 @@
 import { now, safeParse } from "../utils";
-import { TRAINING_CONFIG_VERSION, TrainingStore } from "./model";
+import { TRAINING_CONFIG_VERSION, TrainingSession, TrainingStore } from "./model";
+import { StoreDelta, diffStores, mergeDelta, stampRevisions } from "./sync";
 
-const STORAGE_KEY = "gtocpp.training.store.v1";
+/** v2 layout: `{ version, activeSessionId }` here, and one key per session under the prefix. */
+const STORAGE_KEY = "gtocpp.training.store.v2";
+const SESSION_KEY_PREFIX = `${STORAGE_KEY}.session.`;
+const LEGACY_STORAGE_KEY = "gtocpp.training.store.v1";
 const STORE_EVENT = "gtocpp.training.store.changed";
+const SYNC_CHANNEL = "gtocpp.training.store.sync";
 
 function isBrowser() {
   return typeof window !== "undefined" && typeof window.localStorage !== "undefined";
@@ -10,50 +15,227 @@ function isBrowser() {
 
 function defaultStore(): TrainingStore {
   return {
-    version: 1,
+    version: TRAINING_CONFIG_VERSION,
     activeSessionId: null,
     sessionsById: {},
   };
 }
 
-export function loadStore(): TrainingStore {
-  if (!isBrowser()) return defaultStore();
+/** What the store looks like during SSR / static export (stable, for `useSyncExternalStore`). */
+export const SERVER_STORE: TrainingStore = defaultStore();
+
+/**
+ * Shared in-memory snapshot, so a change costs one parse in total instead of one per reader.
+ * Stores are never mutated, only replaced: the snapshot identity changes exactly when the
+ * store does, which is what selector hooks compare.
+ * - same tab: `saveStore` installs the object it saved (no parse at all) and writes the keys of
+ *   the sessions it changed, and nothing else
+ * - other tabs: the changed sessions arrive over `BroadcastChannel` and are merged into it
+ *   (`sync.ts`); the writer has persisted them already. Without `BroadcastChannel`, the
+ *   `storage` event drops it and the next read parses every key.
+ * A write never undoes another tab's whose delta has not arrived yet: it only touches its own
+ * sessions, each settled against its stored version first (see `reconcileStored`).
+ */
+let snapshot: TrainingStore | null = null;
+let snapshotVersion = 0;
+let legacyStoreLoaded = false;
+let syncInstalled = false;
+let syncChannel: BroadcastChannel | null = null;
+
+const tabId = newId("tab");
+/** Sessions deleted while this tab was open (by any tab). */
+const deletedIds = new Set<string>();
+
+function sessionKey(id: string) {
+  return SESSION_KEY_PREFIX + id;
+}
+
+function isStoreKey(key: string) {
+  return key === STORAGE_KEY || key === LEGACY_STORAGE_KEY || key.startsWith(SESSION_KEY_PREFIX);
+}
+
+/** Whether a `storage` event changes the snapshot (it was dropped if so). */
+function invalidateSnapshot(e: StorageEvent): boolean {
+  if (e.key !== null && !isStoreKey(e.key)) return false;
+  // Writes of tabs that also broadcast their deltas are already merged (`clear()` is not).
+  if (syncChannel && e.key !== null) return false;
+  snapshot = null;
+  snapshotVersion++;
+  return true;
+}
+
+/** Incremented on every change of the store (this tab or another one). */
+export function getStoreVersion(): number {
+  return snapshotVersion;
+}
+
+function installSync() {
+  syncInstalled = true;
+  window.addEventListener("storage", invalidateSnapshot);
+
+  if (typeof BroadcastChannel === "undefined") return;
+  syncChannel = new BroadcastChannel(SYNC_CHANNEL);
+  syncChannel.onmessage = (e: MessageEvent<StoreDelta>) => applyRemoteDelta(e.data);
+}
+
+function applyRemoteDelta(delta: StoreDelta) {
+  if (delta.origin === tabId) return;
+
+  const { store, changed } = mergeDelta(loadStore(), delta, deletedIds);
+  if (!changed) return;
+  snapshot = store;
+  snapshotVersion++;
+  window.dispatchEvent(new Event(STORE_EVENT));
+}
+
+/**
+ * v1 kept every session in localStorage, in one key. Its layout is a subset of v2, so it is read
+ * as-is; the next `saveStore` writes it under the v2 keys and drops the v1 key. Finished sessions
+ * are then moved to IndexedDB by `archiveCompletedSessions`.
+ */
+function loadLegacyStore(): TrainingStore | null {
+  const raw = window.localStorage.getItem(LEGACY_STORAGE_KEY);
+  if (!raw) return null;
+
+  const parsed = safeParse(raw) as { version?: number; sessionsById?: unknown } | null;
+  if (!parsed || parsed.version !== 1 || typeof parsed.sessionsById !== "object") return null;
+
+  return { ...(parsed as unknown as TrainingStore), version: TRAINING_CONFIG_VERSION };
+}
+
+export function hasLegacyStore(): boolean {
+  return isBrowser() && window.localStorage.getItem(LEGACY_STORAGE_KEY) !== null;
+}
+
+function readStore(): TrainingStore {
+  const legacy = loadLegacyStore();
+  legacyStoreLoaded = legacy !== null;
+  if (legacy) return legacy;
 
   const raw = window.localStorage.getItem(STORAGE_KEY);
-  if (!raw) return defaultStore();
-
-  const parsed = safeParse(raw) as TrainingStore | null;
-  if (
-    !parsed ||
-    parsed.version !== TRAINING_CONFIG_VERSION ||
-    typeof parsed.sessionsById !== "object"
-  ) {
-    return defaultStore();
+  const parsed = raw ? (safeParse(raw) as Omit<TrainingStore, "sessionsById"> | null) : null;
+  if (raw && parsed?.version !== TRAINING_CONFIG_VERSION) return defaultStore();
+
+  const store = { ...defaultStore(), activeSessionId: parsed?.activeSessionId ?? null };
+  for (let i = 0; i < window.localStorage.length; i++) {
+    const key = window.localStorage.key(i);
+    if (!key?.startsWith(SESSION_KEY_PREFIX)) continue;
+    const session = safeParse(window.localStorage.getItem(key) ?? "") as TrainingSession | null;
+    if (session?.meta) store.sessionsById[session.meta.id] = session;
   }
+  return store;
+}
 
-  return parsed;
+/** Current store. The returned object is shared: treat it as read-only. */
+export function loadStore(): TrainingStore {
+  if (!isBrowser()) return SERVER_STORE;
+
+  if (!syncInstalled) installSync();
+  snapshot ??= readStore();
+  return snapshot;
 }
 
-export function saveStore(store: TrainingStore): void {
-  if (!isBrowser()) return;
+function isQuotaExceeded(error: unknown) {
+  return (
+    error instanceof DOMException &&
+    (error.name === "QuotaExceededError" || error.name === "NS_ERROR_DOM_QUOTA_REACHED")
+  );
+}
+
+/** `setItem`, dropping the v1 store (read into memory by then) if it is what fills the quota. */
+function writeItem(key: string, value: string) {
+  try {
+    window.localStorage.setItem(key, value);
+  } catch (error) {
+    if (!isQuotaExceeded(error)) throw error;
+    // The only other thing we may own is the v1 store: drop it and retry once. If it still does
+    // not fit, let the caller know.
+    window.localStorage.removeItem(LEGACY_STORAGE_KEY);
+    window.localStorage.setItem(key, value);
+  }
+}
+
+// localStorage only stores strings, so we serialize to JSON.
+function writeSession(session: TrainingSession) {
+  writeItem(sessionKey(session.meta.id), JSON.stringify(session));
+}
+
+function writeStoreKey(store: TrainingStore) {
+  const { version, activeSessionId } = store;
+  writeItem(STORAGE_KEY, JSON.stringify({ version, activeSessionId }));
+}
+
+/**
+ * `next` with the sessions it changes settled against their stored version: another tab may
+ * have written or deleted them since `prev`, its delta not arrived yet. Only the keys of those
+ * sessions are read.
+ */
+function reconcileStored(prev: TrainingStore, next: TrainingStore): TrainingStore {
+  const changes = diffStores(prev, next, tabId);
+  if (!changes) return next;
+
+  const stored: StoreDelta = { origin: "storage", upserts: [], deletes: [] };
+  for (const session of changes.upserts) {
+    const id = session.meta.id;
+    const raw = window.localStorage.getItem(sessionKey(id));
+    const current = raw === null ? null : (safeParse(raw) as TrainingSession | null);
+    if (current) stored.upserts.push(current);
+    else if (raw === null && id in prev.sessionsById) stored.deletes.push(id);
+  }
+  return mergeDelta(next, stored, deletedIds).store;
+}
+
+/** Write what `delta` changed (everything, to move a v1 store to the v2 keys). */
+function writeStore(store: TrainingStore, delta: StoreDelta | null, migrate: boolean) {
+  if (migrate) {
+    for (const session of Object.values(store.sessionsById)) writeSession(session);
+    writeStoreKey(store);
+    window.localStorage.removeItem(LEGACY_STORAGE_KEY);
+    return;
+  }
+
+  for (const session of delta?.upserts ?? []) writeSession(session);
+  for (const id of delta?.deletes ?? []) window.localStorage.removeItem(sessionKey(id));
+  if (delta?.activeSessionId !== undefined) writeStoreKey(store);
+}
+
+/** Write `store` (bumping the revision of the sessions it changed) and return what was written. */
+function commitStore(prev: TrainingStore, next: TrainingStore): TrainingStore {
+  const migrate = legacyStoreLoaded && hasLegacyStore();
+  legacyStoreLoaded = false;
+
+  const stamped = stampRevisions(prev, next);
+  const store = migrate ? stamped : reconcileStored(prev, stamped);
+  const delta = diffStores(prev, store, tabId);
+  for (const id of delta?.deletes ?? []) deletedIds.add(id);
+  writeStore(store, delta, migrate);
+
+  snapshot = store;
+  snapshotVersion++;
 
-  // localStorage only stores strings, so we serialize to JSON.
-  window.localStorage.setItem(STORAGE_KEY, JSON.stringify(store));
   // Same-tab notification (storage event does not fire in the same document).
   window.dispatchEvent(new Event(STORE_EVENT));
+  if (delta) syncChannel?.postMessage(delta);
+  return store;
+}
+
+export function saveStore(store: TrainingStore): void {
+  if (!isBrowser()) return;
+  commitStore(loadStore(), store);
 }
 
 /**
  * Subscribe to any change of the training store.
- * - Same tab: the custom event
- * - Other tabs: the native `storage` event
+ * - Same tab, and other tabs' deltas: the custom event
+ * - Other tabs without `BroadcastChannel`: the native `storage` event
  */
 export function subscribeStore(listener: () => void): () => void {
   if (!isBrowser()) return () => {};
 
   const onCustom = () => listener();
   const onStorage = (e: StorageEvent) => {
-    if (e.key === STORAGE_KEY) listener();
+    // Listeners may run before the module one: make sure they do not read a stale snapshot.
+    if (invalidateSnapshot(e)) listener();
   };
 
   window.addEventListener(STORE_EVENT, onCustom);
@@ -68,10 +250,8 @@ export function subscribeStore(listener: () => void): () => void {
 export function updateStore(updater: (prev: TrainingStore) => TrainingStore): TrainingStore {
   const prev = loadStore();
   const next = updater(prev);
-  if (next !== prev) {
-    saveStore(next);
-  }
-  return next;
+  if (next === prev || !isBrowser()) return next;
+  return commitStore(prev, next);
 }
 
 export function newId(prefix = "ts"): string {
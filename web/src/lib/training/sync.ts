@@ -0,0 +1,124 @@
+import { structuralEqual } from "../utils";
+import type { TrainingSession, TrainingStore } from "./model";
+
+/**
+ * Cross-tab store changes, sent over `BroadcastChannel` by `saveStore` (see `storage.ts`).
+ *
+ * Every write goes through a whole-store updater that keeps untouched sessions by reference, so
+ * the changed sessions are found by identity and only those are sent: a receiving tab applies
+ * them to its in-memory snapshot in O(changed sessions) instead of re-parsing the whole store.
+ *
+ * Each session carries a revision (`rev`), bumped on every write. Two tabs writing the same
+ * session from the same base produce equal revisions with different contents: both tabs settle
+ * on the same winner (`pickSession`). The second writer compares with the stored version before
+ * writing, so localStorage ends up with the winner whatever the write order was.
+ */
+export type StoreDelta = {
+  origin: string; // tab id of the writer
+  upserts: TrainingSession[];
+  deletes: string[];
+  activeSessionId?: string | null; // only when it changed
+};
+
+export function sessionRev(session: TrainingSession): number {
+  return session.rev ?? 0;
+}
+
+/** Bump the revision of every session `next` changed or added (by identity) compared to `prev`. */
+export function stampRevisions(prev: TrainingStore, next: TrainingStore): TrainingStore {
+  let sessionsById: Record<string, TrainingSession> | null = null;
+
+  for (const [id, session] of Object.entries(next.sessionsById)) {
+    const before = prev.sessionsById[id as string];
+    if (session === before) continue;
+
+    sessionsById ??= { ...next.sessionsById };
+    sessionsById[id as string] = { ...session, rev: (before ? sessionRev(before) : 0) + 1 };
+  }
+
+  return sessionsById ? { ...next, sessionsById } : next;
+}
+
+export function diffStores(
+  prev: TrainingStore,
+  next: TrainingStore,
+  origin: string
+): StoreDelta | null {
+  const upserts = Object.entries(next.sessionsById)
+    .filter(([id, session]) => prev.sessionsById[id as string] !== session)
+    .map(([, session]) => session);
+  const deletes = Object.keys(prev.sessionsById).filter((id) => !(id in next.sessionsById));
+  const activeChanged = prev.activeSessionId !== next.activeSessionId;
+
+  if (upserts.length === 0 && deletes.length === 0 && !activeChanged) return null;
+  return {
+    origin,
+    upserts,
+    deletes,
+    ...(activeChanged ? { activeSessionId: next.activeSessionId } : {}),
+  };
+}
+
+/**
+ * Winner between two versions of a session. Only depends on the two versions (not on which one
+ * is local), so every tab picks the same one.
+ */
+export function pickSession(a: TrainingSession, b: TrainingSession): TrainingSession {
+  if (sessionRev(a) !== sessionRev(b)) return sessionRev(a) > sessionRev(b) ? a : b;
+  if (a.progress.updatedAt !== b.progress.updatedAt) {
+    return a.progress.updatedAt > b.progress.updatedAt ? a : b;
+  }
+  return JSON.stringify(a) >= JSON.stringify(b) ? a : b;
+}
+
+export type MergeResult = {
+  store: TrainingStore;
+  changed: boolean;
+};
+
+/**
+ * Apply a delta from another tab (or the stored versions of sessions about to be written).
+ * `deleted` holds the ids this tab knows were deleted: an update racing a deletion does not
+ * bring the session back. Local versions that win are kept.
+ */
+export function mergeDelta(
+  store: TrainingStore,
+  delta: StoreDelta,
+  deleted: Set<string>
+): MergeResult {
+  let sessionsById: Record<string, TrainingSession> | null = null;
+  let activeSessionId = store.activeSessionId;
+
+  for (const id of delta.deletes) {
+    deleted.add(id);
+    if (!(id in store.sessionsById)) continue;
+    sessionsById ??= { ...store.sessionsById };
+    delete sessionsById[id as string];
+    if (activeSessionId === id) activeSessionId = null;
+  }
+
+  for (const remote of delta.upserts) {
+    const id = remote.meta.id;
+    if (deleted.has(id)) continue;
+
+    const local = store.sessionsById[id as string];
+    if (local && (local === remote || structuralEqual(local, remote))) continue;
+
+    if (local && pickSession(local, remote) === local) continue;
+    sessionsById ??= { ...store.sessionsById };
+    sessionsById[id as string] = remote;
+  }
+
+  if (delta.activeSessionId !== undefined) {
+    const id = delta.activeSessionId;
+    if (id === null || id in (sessionsById ?? store.sessionsById)) activeSessionId = id;
+  }
+
+  const changed = sessionsById !== null || activeSessionId !== store.activeSessionId;
+  return {
+    store: changed
+      ? { ...store, activeSessionId, sessionsById: sessionsById ?? store.sessionsById }
+      : store,
+    changed,
+  };
+}
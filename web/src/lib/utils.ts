@@ -12,12 +12,6 @@ export function formatMMSS(totalSeconds: number) {
   return `${mm}:${String(ss).padStart(2, "0")}`;
 }
 
-export function intersects(a: string[], b: string[]) {
-  if (a.length === 0) return true;
-  const setB = new Set(b);
-  return a.some((x) => setB.has(x));
-}
-
 export function formatDateTime(ts: number) {
   // Uses user's locale by default.
   return new Intl.DateTimeFormat(undefined, {
@@ -37,6 +31,28 @@ export function clampNonNegative(n: number) {
   return n < 0 ? 0 : n;
 }
 
+/** Deep equality for JSON-like values (plain objects, arrays, primitives). */
+export function structuralEqual(a: unknown, b: unknown): boolean {
+  if (Object.is(a, b)) return true;
+  if (typeof a !== "object" || typeof b !== "object" || a === null || b === null) return false;
+
+  if (Array.isArray(a)) {
+    if (!Array.isArray(b) || a.length !== b.length) return false;
+    return a.every((value, i) => structuralEqual(value, b[i as number]));
+  }
+  if (Array.isArray(b)) return false;
+
+  const aKeys = Object.keys(a);
+  if (aKeys.length !== Object.keys(b).length) return false;
+  const aRecord = a as Record<string, unknown>;
+  const bRecord = b as Record<string, unknown>;
+  for (const key of aKeys) {
+    if (!Object.hasOwn(bRecord, key)) return false;
+    if (!structuralEqual(aRecord[key as string], bRecord[key as string])) return false;
+  }
+  return true;
+}
+
 export function safeParse(json: string): unknown {
   try {
     return JSON.parse(json);
@@ -0,0 +1,68 @@
+import assert from "node:assert/strict";
+import { test } from "node:test";
+
+import {
+  createRng,
+  sampleWithoutReplacement,
+  stratifiedSample,
+} from "../src/lib/training/sampling.ts";
+
+// Chi-square critical value for df = 27 ((slot, item) cells of k=3 of n=10, minus 3), p = 0.001.
+const CHI2_CRITICAL_DF27_P001 = 55.5;
+
+test("sampleWithoutReplacement draws every item at every slot uniformly", () => {
+  const n = 10;
+  const k = 3;
+  const draws = 200_000;
+  const rng = createRng(1);
+  const items = Array.from({ length: n }, (_, i) => i);
+  const counts = new Float64Array(n * k);
+
+  for (let t = 0; t < draws; t++) {
+    const picked = sampleWithoutReplacement(items, k, rng);
+    assert.equal(new Set(picked).size, k);
+    for (let slot = 0; slot < k; slot++) counts[slot * n + picked[slot]]++;
+  }
+
+  const expected = draws / n;
+  let chi2 = 0;
+  for (const c of counts) chi2 += (c - expected) ** 2 / expected;
+  assert.ok(chi2 < CHI2_CRITICAL_DF27_P001, `chi2 = ${chi2.toFixed(1)}`);
+});
+
+/** Items `${stratum}-${i}`, `sizes[s]` of stratum s + 1. */
+function stratifiedItems(sizes) {
+  return sizes.flatMap((size, s) => Array.from({ length: size }, (_, i) => `${s + 1}-${i}`));
+}
+
+const stratumOf = (item) => Number(item.split("-")[0]);
+
+function countsByStratum(sample, strata) {
+  return Array.from(
+    { length: strata },
+    (_, s) => sample.filter((item) => stratumOf(item) === s + 1).length
+  );
+}
+
+test("stratifiedSample gives each stratum its largest-remainder share", () => {
+  const cases = [
+    // quotas 2, 1.2, 0.8: the one left over goes to the largest remainder (0.8)
+    { sizes: [5, 3, 2], k: 4, expected: [2, 1, 1] },
+    // quotas 10/3 each: ties go to the first stratum
+    { sizes: [7, 7, 7], k: 10, expected: [4, 3, 3] },
+    // quotas 1.5, 1.5, 1: the two halves tie, the first one wins
+    { sizes: [3, 3, 2], k: 4, expected: [2, 1, 1] },
+    // more than there is: everything
+    { sizes: [2, 1], k: 5, expected: [2, 1] },
+  ];
+
+  for (const { sizes, k, expected } of cases) {
+    const items = stratifiedItems(sizes);
+    const sample = stratifiedSample(items.slice().reverse(), k, stratumOf, createRng(7));
+
+    assert.deepEqual(countsByStratum(sample, sizes.length), expected, `sizes ${sizes}, k = ${k}`);
+    assert.equal(new Set(sample).size, sample.length);
+    // Strata in ascending order.
+    assert.deepEqual(sample.map(stratumOf), sample.map(stratumOf).sort((a, b) => a - b));
+  }
+});
@@ -0,0 +1,160 @@
+// Two tabs sharing one localStorage: each tab is its own instance of `storage.ts` (imported with
+// a distinct query), and their BroadcastChannel deltas arrive on a later task, as in a browser.
+import assert from "node:assert/strict";
+import { test } from "node:test";
+
+class MemoryStorage {
+  #items = new Map();
+  writes = 0;
+  get length() {
+    return this.#items.size;
+  }
+  key(index) {
+    return Array.from(this.#items.keys())[index] ?? null;
+  }
+  getItem(key) {
+    return this.#items.get(key) ?? null;
+  }
+  setItem(key, value) {
+    this.writes++;
+    this.#items.set(key, String(value));
+  }
+  removeItem(key) {
+    this.#items.delete(key);
+  }
+}
+
+const channels = new Set();
+
+class LocalBroadcastChannel {
+  onmessage = null;
+  constructor(name) {
+    this.name = name;
+    channels.add(this);
+  }
+  postMessage(data) {
+    for (const channel of channels) {
+      if (channel === this || channel.name !== this.name) continue;
+      const message = structuredClone(data);
+      setTimeout(() => channel.onmessage?.({ data: message }));
+    }
+  }
+  close() {
+    channels.delete(this);
+  }
+}
+
+globalThis.window = Object.assign(new EventTarget(), { localStorage: new MemoryStorage() });
+globalThis.BroadcastChannel = LocalBroadcastChannel;
+
+const SESSION_KEY_PREFIX = "gtocpp.training.store.v2.session.";
+
+function makeSession(id, t) {
+  return {
+    meta: { id, title: id, createdAt: t, lastOpenedAt: t, status: "active" },
+    config: { difficultyMin: 1, difficultyMax: 5, concepts: [], problemsPerSession: 1 },
+    problemIds: ["p0001"],
+    progress: {
+      currentIndex: 0,
+      attemptsOnCurrent: 0,
+      score: { solved: 0, failed: 0, attemptsTotal: 0, correctOnFirstTry: 0 },
+      timers: { sessionSecondsRemaining: null, problemSecondsRemaining: null, lastTickAt: t },
+      startedAt: t,
+      updatedAt: t,
+    },
+  };
+}
+
+function addSession(session) {
+  return (store) => ({
+    ...store,
+    sessionsById: { ...store.sessionsById, [session.meta.id]: session },
+  });
+}
+
+function removeSession(id) {
+  return (store) => {
+    const sessionsById = { ...store.sessionsById };
+    delete sessionsById[id];
+    return { ...store, sessionsById };
+  };
+}
+
+function storedIds() {
+  const ids = [];
+  for (let i = 0; i < window.localStorage.length; i++) {
+    const key = window.localStorage.key(i);
+    if (key.startsWith(SESSION_KEY_PREFIX)) ids.push(key.slice(SESSION_KEY_PREFIX.length));
+  }
+  return ids.sort();
+}
+
+function sessionIds(tab) {
+  return Object.keys(tab.loadStore().sessionsById).sort();
+}
+
+const deliverBroadcasts = () => new Promise((resolve) => setTimeout(resolve, 10));
+
+let tabs = 0;
+async function openTab() {
+  tabs++;
+  const tab = await import(`../src/lib/training/storage.ts?tab=${tabs}`);
+  tab.loadStore();
+  return tab;
+}
+
+test("a write racing another tab's keeps both sessions in localStorage", async () => {
+  const a = await openTab();
+  const b = await openTab();
+
+  a.updateStore(addSession(makeSession("x", 1)));
+  // B writes before A's broadcast arrives: its write must not drop x.
+  b.updateStore(addSession(makeSession("y", 2)));
+  assert.deepEqual(storedIds(), ["x", "y"]);
+
+  // Receiving tabs only merge the delta: the writer has persisted it.
+  const writes = window.localStorage.writes;
+  await deliverBroadcasts();
+  assert.equal(window.localStorage.writes, writes);
+  assert.deepEqual(storedIds(), ["x", "y"]);
+  assert.deepEqual(sessionIds(a), ["x", "y"]);
+  assert.deepEqual(sessionIds(b), ["x", "y"]);
+
+  // What a reload (or a new tab) reads.
+  const c = await openTab();
+  assert.deepEqual(sessionIds(c), ["x", "y"]);
+});
+
+test("a deletion racing another tab's write stays deleted", async () => {
+  const a = await openTab();
+  const b = await openTab();
+  await deliverBroadcasts();
+
+  a.updateStore(removeSession("x"));
+  b.updateStore(addSession(makeSession("z", 3)));
+
+  await deliverBroadcasts();
+  assert.deepEqual(storedIds(), ["y", "z"]);
+  assert.deepEqual(sessionIds(a), ["y", "z"]);
+  assert.deepEqual(sessionIds(b), ["y", "z"]);
+});
+
+test("a deletion whose delta has not arrived is not undone by another tab's writes", async () => {
+  const a = await openTab();
+  const b = await openTab();
+  await deliverBroadcasts();
+
+  a.updateStore(removeSession("y"));
+  // B still has y: neither a write to another session nor one to y itself brings it back.
+  b.updateStore(addSession(makeSession("w", 4)));
+  assert.deepEqual(storedIds(), ["w", "z"]);
+  b.updateStore(addSession(makeSession("y", 5)));
+  assert.deepEqual(storedIds(), ["w", "z"]);
+  assert.deepEqual(sessionIds(b), ["w", "z"]);
+
+  await deliverBroadcasts();
+  assert.deepEqual(sessionIds(a), ["w", "z"]);
+  assert.deepEqual(sessionIds(b), ["w", "z"]);
+  const c = await openTab();
+  assert.deepEqual(sessionIds(c), ["w", "z"]);
+});